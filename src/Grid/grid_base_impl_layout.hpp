@@ -39,6 +39,27 @@ struct allocate
 	}
 };
 
+/*! \brief this class is a functor for "for_each" algorithm
+ *
+ * For each member it grow the memory retaining the content
+ *
+ */
+struct grow_mem
+{
+	//! new size
+	size_t sz;
+
+	//! constructor it fix the size
+	grow_mem(size_t sz)
+	:sz(sz){};
+
+	//! It call the grow function for each member
+	template<typename T>
+	void operator()(T& t) const
+	{
+		t.grow(sz);
+	}
+};
 
 /*! \brief this class is a functor for "for_each" algorithm
  *
@@ -215,4 +236,50 @@ struct mem_swap<T,layout,data_type,grid_type,1>
 	}
 };
 
+//! Case memory_traits_lin
+template<unsigned int p, typename layout, typename data_type, unsigned int sel = 2*is_layout_mlin<layout>::value + is_layout_inte<layout>::value >
+struct mem_getpointer
+{
+	static inline void * getPointer(data_type & data_)
+	{
+		// all the properties are in the same buffer
+		return data_.mem_r->get_pointer();
+	}
+};
+
+//! Case memory_traits_inte
+template<unsigned int p, typename layout, typename data_type>
+struct mem_getpointer<p,layout,data_type,1>
+{
+	static inline void * getPointer(data_type & data_)
+	{
+		// every property has its own buffer
+		return boost::fusion::at_c<p>(data_).mem->getPointer();
+	}
+};
+
+//! Case memory_traits_lin
+template<typename layout, typename data_type, unsigned int sel = 2*is_layout_mlin<layout>::value + is_layout_inte<layout>::value >
+struct mem_grow
+{
+	static inline void grow(data_type & data_, size_t sz)
+	{
+		// all the properties are in the same buffer
+		data_.grow(sz);
+	}
+};
+
+//! Case memory_traits_inte
+template<typename layout, typename data_type>
+struct mem_grow<layout,data_type,1>
+{
+	static inline void grow(data_type & data_, size_t sz)
+	{
+		grow_mem gr(sz);
+
+		// every property has its own buffer
+		boost::fusion::for_each(data_,gr);
+	}
+};
+
 #endif /* OPENFPM_DATA_SRC_GRID_GRID_BASE_IMPL_LAYOUT_HPP_ */
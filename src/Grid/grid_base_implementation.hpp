@@ -10,6 +10,7 @@
 
 #include "grid_base_impl_layout.hpp"
 #include "copy_grid_fast.hpp"
+#include "util/check_no_pointers.hpp"
 
 /*! \brief
  *
@@ -440,6 +441,24 @@ public:
 		return data_.mem_r->get_pointer();
 	}
 
+	/*! \brief Return a plain pointer to the buffer that contain the property p
+	 *
+	 * With memory_traits_lin all the properties are in the same buffer (the pointer returned is
+	 * the same of getPointer()), with memory_traits_inte every property has its own buffer
+	 *
+	 * \tparam p property
+	 *
+	 * \return plain data pointer
+	 *
+	 */
+	template<unsigned int p> void * getPointer()
+	{
+#ifdef SE_CLASS2
+		check_valid(this,8);
+#endif
+		return mem_getpointer<p,layout_base<T>,decltype(data_)>::getPointer(data_);
+	}
+
 	/*! \brief Get the reference of the selected element
 	 *
 	 * \param v1 grid_key that identify the element in the grid
@@ -626,6 +645,24 @@ public:
 		memset(getPointer(),fl,size() * sizeof(T));
 	}
 
+	/*! \brief Check if the new size grow only the last dimension
+	 *
+	 * \param sz new size
+	 *
+	 * \return true if the new size differ from the actual only by a bigger last dimension
+	 *
+	 */
+	bool grow_last(const size_t (& sz)[dim]) const
+	{
+		for (size_t i = 0 ; i < dim - 1 ; i++)
+		{
+			if (sz[i] != g1.size(i))
+				return false;
+		}
+
+		return sz[dim-1] > g1.size(dim-1);
+	}
+
 	/*! \brief Resize the space
 	 *
 	 * Resize the space to a new grid, the element are retained on the new grid,
@@ -640,6 +677,18 @@ public:
 #ifdef SE_CLASS2
 		check_valid(this,8);
 #endif
+		// If only the last dimension grow the elements retain their linear id, for types
+		// without pointers the memory object grow the buffer (in place if it can) without
+		// a new grid and an element by element copy
+
+		if (isExternal == false && is_mem_init == true && check_no_pointers<T>::value() == PNP::NO_POINTERS && grow_last(sz) == true)
+		{
+			mem_grow<layout_base<T>,decltype(this->data_)>::grow(data_,grid_sm<dim,void>(sz).size());
+			g1.setDimensions(sz);
+
+			return;
+		}
+
 		//! Create a completely new grid with sz
 
 		grid_base_impl<dim,T,S,layout,layout_base> grid_new(sz);
@@ -931,6 +931,54 @@ BOOST_AUTO_TEST_CASE(grid_resize_less)
 	BOOST_REQUIRE_EQUAL(g1.size(),25ul);
 }
 
+BOOST_AUTO_TEST_CASE(grid_resize_grow_last)
+{
+	typedef Point_test<float> P;
+
+	size_t sz1[] = {16,16};
+	size_t sz2[] = {16,64};
+
+	grid_cpu<2,Point_test<float>> g1(sz1);
+	g1.setMemory();
+
+	auto it = g1.getIterator();
+
+	while (it.isNext())
+	{
+		auto key = it.get();
+
+		g1.template get<P::x>(key) = key.get(0);
+		g1.template get<P::y>(key) = key.get(1);
+		g1.template get<P::v>(key)[2] = key.get(0) + key.get(1);
+		g1.template get<P::t>(key)[2][1] = key.get(0) * key.get(1);
+
+		++it;
+	}
+
+	// only the last dimension grow, the content is retained
+
+	g1.resize(sz2);
+
+	BOOST_REQUIRE_EQUAL(g1.size(),16ul*64ul);
+
+	auto it2 = g1.getIterator();
+
+	while (it2.isNext())
+	{
+		auto key = it2.get();
+
+		if (key.get(1) < 16)
+		{
+			BOOST_REQUIRE_EQUAL(g1.template get<P::x>(key),key.get(0));
+			BOOST_REQUIRE_EQUAL(g1.template get<P::y>(key),key.get(1));
+			BOOST_REQUIRE_EQUAL(g1.template get<P::v>(key)[2],key.get(0) + key.get(1));
+			BOOST_REQUIRE_EQUAL(g1.template get<P::t>(key)[2][1],key.get(0) * key.get(1));
+		}
+
+		++it2;
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif
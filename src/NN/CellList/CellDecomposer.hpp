@@ -554,6 +554,82 @@ protected:
 		p_middle = p_middle / 2;
 	}
 
+	/*! \brief Calculate the cell-id of a set of points
+	 *
+	 * It produce the same result of getCell (getCellDom if dom is true) for each point, but
+	 * it proceed one dimension at time over all the points with loops without branches,
+	 * so that the compiler can vectorize them
+	 *
+	 * \tparam dom true to force the points in the domain cells like getCellDom
+	 *
+	 * \param x pointer to the first coordinate of each dimension
+	 * \param stride distance between the coordinates of two consecutive points
+	 * \param n number of points
+	 * \param out cell-id of each point
+	 *
+	 */
+	template<bool dom> inline void getCells_impl(const T * const (& x)[dim], size_t stride, size_t n, size_t * out) const
+	{
+		for (size_t k = 0 ; k < n ; k++)
+			out[k] = 0;
+
+		for (size_t s = 0 ; s < dim ; s++)
+		{
+			const T * xs = x[s];
+
+			const T o = t.getOrig().get(s);
+			const T u = box_unit.getHigh(s);
+			const long int of = off[s];
+			const long int sz = gr_cell.size(s);
+			const long int sh = cell_shift.get(s);
+			const size_t st = (s == 0)?1:gr_cell2.size_s(s-1);
+
+			for (size_t k = 0 ; k < n ; k++)
+			{
+				T v = (xs[k*stride] - o) / u;
+
+				// floor as openfpm::math::size_t_floor
+				long int id = (long int)v;
+				id -= (id < 0) | (id > v);
+				id += of;
+
+				// points outside the grid go in the last cell like ConvertToID
+				id = ((size_t)id >= (size_t)sz)?sz - 1:id;
+
+				if (dom == true)
+				{
+					id = (id == sz - of)?sz - of - 1:id;
+					id = (id == of - 1)?of:id;
+				}
+
+				out[k] += st * (id - sh);
+			}
+		}
+	}
+
+	/*! \brief Calculate the cell-id of the points in [start,stop) of a vector of positions
+	 *
+	 * \tparam dom true to force the points in the domain cells like getCellDom
+	 *
+	 * \param pos vector of positions
+	 * \param start first point
+	 * \param stop last point (excluded)
+	 * \param out cell-id of each point (out[0] is the cell of the point start)
+	 *
+	 */
+	template<bool dom> inline void getCells_impl(const openfpm::vector<Point<dim,T>> & pos, size_t start, size_t stop, size_t * out) const
+	{
+		if (start >= stop)
+			return;
+
+		const T * x[dim];
+
+		for (size_t s = 0 ; s < dim ; s++)
+			x[s] = &pos.template get<0>(start)[s];
+
+		getCells_impl<dom>(x,dim,stop - start,out);
+	}
+
 public:
 
 	/*! \brief Return the underlying grid information of the cell list
@@ -925,6 +1001,68 @@ public:
 		return cell_id;
 	}
 
+	/*! \brief Get the cell-id of all the points
+	 *
+	 * It is equivalent to call getCell for each point, but the calculation is
+	 * vectorized across the points
+	 *
+	 * \param pos vector of positions
+	 * \param out cell-id of each point
+	 *
+	 */
+	inline void getCells(const openfpm::vector<Point<dim,T>> & pos, openfpm::vector<size_t> & out) const
+	{
+		out.resize(pos.size());
+
+		if (pos.size() != 0)
+			getCells_impl<false>(pos,0,pos.size(),&out.get(0));
+	}
+
+	/*! \brief Get the cell-id of all the points (Structure of Arrays layout)
+	 *
+	 * It is equivalent to call getCell for each point, but the calculation is
+	 * vectorized across the points
+	 *
+	 * \param x array of coordinates for each dimension
+	 * \param n number of points
+	 * \param out cell-id of each point
+	 *
+	 */
+	inline void getCells(const T * const (& x)[dim], size_t n, size_t * out) const
+	{
+		getCells_impl<false>(x,1,n,out);
+	}
+
+	/*! \brief Get the cell-id of all the points forcing them to be in the domain cells
+	 *
+	 * It is equivalent to call getCellDom for each point
+	 *
+	 * \param pos vector of positions
+	 * \param out cell-id of each point
+	 *
+	 */
+	inline void getCellsDom(const openfpm::vector<Point<dim,T>> & pos, openfpm::vector<size_t> & out) const
+	{
+		out.resize(pos.size());
+
+		if (pos.size() != 0)
+			getCells_impl<true>(pos,0,pos.size(),&out.get(0));
+	}
+
+	/*! \brief Get the cell-id of all the points forcing them to be in the domain cells (Structure of Arrays layout)
+	 *
+	 * It is equivalent to call getCellDom for each point
+	 *
+	 * \param x array of coordinates for each dimension
+	 * \param n number of points
+	 * \param out cell-id of each point
+	 *
+	 */
+	inline void getCellsDom(const T * const (& x)[dim], size_t n, size_t * out) const
+	{
+		getCells_impl<true>(x,1,n,out);
+	}
+
 	/*! \brief Return the smallest box containing the grid points
 	 *
 	 * Suppose a grid 5x5 defined on a Box<2,float> box({0.0,0.0},{1.0,1.0})
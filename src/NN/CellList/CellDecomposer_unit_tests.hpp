@@ -288,6 +288,93 @@ BOOST_AUTO_TEST_CASE( CellDecomposer_swap_use )
 	BOOST_REQUIRE(cd1 == cd2_old);
 }
 
+/*! \brief Check that getCells/getCellsDom give the same cells of getCell/getCellDom
+ *
+ * \param cd Cell decomposer
+ * \param box box where to generate the points (it can be bigger than the domain)
+ *
+ */
+template<typename CellD> void test_get_cells(const CellD & cd, const Box<3,double> & box)
+{
+	openfpm::vector<Point<3,double>> pos;
+
+	std::default_random_engine g;
+
+	for (size_t i = 0 ; i < 10000 ; i++)
+	{
+		Point<3,double> p;
+
+		for (size_t j = 0 ; j < 3 ; j++)
+		{
+			std::uniform_real_distribution<double> d(box.getLow(j),box.getHigh(j));
+			p.get(j) = d(g);
+		}
+
+		// some points exactly on the cell borders
+		if (i % 10 == 0)
+		{
+			for (size_t j = 0 ; j < 3 ; j++)
+				p.get(j) = box.getLow(j) + (i / 10 % 20) * (box.getHigh(j) - box.getLow(j)) / 20;
+		}
+
+		pos.add(p);
+	}
+
+	openfpm::vector<size_t> cells;
+	openfpm::vector<size_t> cells_dom;
+
+	cd.getCells(pos,cells);
+	cd.getCellsDom(pos,cells_dom);
+
+	// Structure of Arrays
+	openfpm::vector<double> x[3];
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{
+		for (size_t j = 0 ; j < 3 ; j++)
+			x[j].add(pos.template get<0>(i)[j]);
+	}
+
+	const double * xp[3] = {&x[0].get(0),&x[1].get(0),&x[2].get(0)};
+	openfpm::vector<size_t> cells_soa(pos.size());
+	cd.getCells(xp,pos.size(),&cells_soa.get(0));
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{
+		Point<3,double> p = pos.template get<0>(i);
+
+		BOOST_REQUIRE_EQUAL(cells.get(i),cd.getCell(p));
+		BOOST_REQUIRE_EQUAL(cells_soa.get(i),cd.getCell(p));
+		BOOST_REQUIRE_EQUAL(cells_dom.get(i),cd.getCellDom(p));
+	}
+}
+
+BOOST_AUTO_TEST_CASE( CellDecomposer_get_cells )
+{
+	size_t div[3] = {16,16,16};
+
+	SpaceBox<3,double> box({0.0f,0.0f,0.0f},{1.0f,1.0f,1.0f});
+	Point<3,double> sht({1.1,2.1,3.1});
+	SpaceBox<3,double> box2 = box;
+	box2 += sht;
+
+	// points in the domain and in the padding
+	Box<3,double> ext_box({-0.06,-0.06,-0.06},{1.06,1.06,1.06});
+	Box<3,double> ext_box2 = ext_box;
+	ext_box2 += sht;
+
+	CellDecomposer_sm<3,double> cd(box,div,1);
+	test_get_cells(cd,ext_box);
+
+	CellDecomposer_sm< 3,double,shift<3,double> > cd_s(box2,div,1);
+	test_get_cells(cd_s,ext_box2);
+
+	// with cell shift
+	Box<3,size_t> ext({1,2,3},{1,1,1});
+	CellDecomposer_sm< 3,double,shift<3,double> > cd2(cd_s,ext);
+	test_get_cells(cd2,ext_box2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLDECOMPOSER_UNIT_TESTS_HPP_ */
@@ -13,9 +13,16 @@
 #include "Space/SpaceBox.hpp"
 #include "util/mathutil.hpp"
 #include "CellNNIterator.hpp"
+#include "CellNNIteratorPeriodic.hpp"
+#include "CellTileIterator.hpp"
 #include "Space/Shape/HyperCube.hpp"
 #include "CellListNNIteratorRadius.hpp"
 #include <unordered_map>
+#include <algorithm>
+#include <limits>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "CellListIterator.hpp"
 #include "ParticleIt_Cells.hpp"
@@ -25,7 +32,10 @@
 #include "NN/Mem_type/MemFast.hpp"
 #include "NN/Mem_type/MemBalanced.hpp"
 #include "NN/Mem_type/MemMemoryWise.hpp"
+#include "NN/Mem_type/MemCompact.hpp"
+#include "NN/Mem_type/MemSparse.hpp"
 #include "NN/CellList/NNc_array.hpp"
+#include "NN/CellList/CellList_util.hpp"
 
 //! Wrapper of the unordered map
 template<typename key,typename val>
@@ -51,6 +61,9 @@ class wrap_unordered_map<boost::multiprecision::float128,val>
 
 #define STARTING_NSLOT 16
 
+//! Id returned by getKNN_all in the slots not filled (the particle has less than k neighborhood)
+#define KNN_NO_PARTICLE ((size_t)-1)
+
 /*! \brief Calculate the the Neighborhood for symmetric interactions CSR scheme
  *
  * \param cNN calculated cross neighborhood
@@ -265,7 +278,7 @@ template<unsigned int dim> void NNcalc_full(openfpm::vector<grid_key_dx<dim>> &
  * \snippet CellList_test.hpp Usage of the neighborhood iterator
  *
  */
-template<unsigned int dim, typename T,  typename Mem_type, typename transform = no_transform<dim,T>, typename base=openfpm::vector<size_t>>
+template<unsigned int dim, typename T,  typename Mem_type, typename transform = no_transform<dim,T>, typename base=openfpm::vector<typename Mem_type::loc_index>>
 class CellList : public CellDecomposer_sm<dim,T,transform>, public Mem_type
 {
 protected:
@@ -299,6 +312,33 @@ private:
 	//! has been constructed from an old decomposition
 	size_t n_dec;
 
+	//! Cell of each particle (filled by fill and used by update)
+	openfpm::vector<size_t> cell_keys;
+
+	//! New cell of each particle (temporary buffer used by update)
+	openfpm::vector<size_t> cell_keys_new;
+
+	//! Position of each particle inside its cell (filled by fill and used by update)
+	openfpm::vector<typename Mem_type::loc_index> part_slot;
+
+	//! True if cell_keys and part_slot describe the content of the Cell-list
+	bool inc_ready;
+
+	//! ghost marker used by the last fill
+	size_t inc_g_m;
+
+	//! option used by the last fill
+	size_t inc_opt;
+
+	//! Number of particles in each cell (temporary buffer used by fill)
+	openfpm::vector<typename Mem_type::loc_index> cell_cnt;
+
+	//! Number of particles in each cell for each thread (temporary buffer used by fill)
+	openfpm::vector<typename Mem_type::loc_index> thr_cnt;
+
+	//! Maximum number of threads used by fill (1 = serial construction)
+	size_t n_thr;
+
 	/*! Calculate the neighborhood cells based on the radius
 	 *
 	 * \note To the calculated neighborhood cell you have to add the id of the central cell
@@ -367,6 +407,8 @@ private:
 	{
 		Mem_type::init_to_zero(slot,tot_n_cell);
 
+		inc_ready = false;
+
 		NNc_full.set_size(div);
 		NNc_full.init_full();
 
@@ -374,6 +416,256 @@ private:
 		NNc_sym.init_sym();
 	}
 
+	/*! \brief Calculate the cell of the particle i as fill does
+	 *
+	 * \param pos vector of positions
+	 * \param i particle
+	 * \param g_m marker
+	 * \param opt option like CL_SYMMETRIC or CL_NON_SYMMETRIC
+	 *
+	 * \return the cell id
+	 *
+	 */
+	inline size_t fill_cell(const openfpm::vector<Point<dim,T>> & pos, size_t i, size_t g_m, size_t opt) const
+	{
+		if (opt == CL_NON_SYMMETRIC || i >= g_m)
+			return this->getCell(pos.template get<0>(i));
+
+		return this->getCellDom(pos.template get<0>(i));
+	}
+
+	/*! \brief Calculate the cells of the particles in [start,stop) as fill does
+	 *
+	 * The cells are calculated with the vectorized getCells_impl
+	 *
+	 * \param pos vector of positions
+	 * \param start first particle
+	 * \param stop last particle (excluded)
+	 * \param g_m marker
+	 * \param opt option like CL_SYMMETRIC or CL_NON_SYMMETRIC
+	 * \param out cell of each particle (indexed by particle id)
+	 *
+	 */
+	inline void fill_cells(const openfpm::vector<Point<dim,T>> & pos, size_t start, size_t stop, size_t g_m, size_t opt, openfpm::vector<size_t> & out) const
+	{
+		if (start >= stop)
+			return;
+
+		if (opt == CL_NON_SYMMETRIC)
+		{
+			this->template getCells_impl<false>(pos,start,stop,&out.get(start));
+			return;
+		}
+
+		// domain particles are forced in the domain cells
+		size_t m = (g_m < start)?start:((g_m > stop)?stop:g_m);
+
+		this->template getCells_impl<true>(pos,start,m,&out.get(start));
+		this->template getCells_impl<false>(pos,m,stop,&out.get(m));
+	}
+
+	/*! \brief Fill the cell-list serially (see fill)
+	 *
+	 * \param pos vector of positions
+	 * \param g_m marker
+	 * \param opt option like CL_SYMMETRIC or CL_NON_SYMMETRIC
+	 *
+	 */
+	void fill_impl(const openfpm::vector<Point<dim,T>> & pos, size_t g_m, size_t opt, std::false_type)
+	{
+		cell_keys.resize(pos.size());
+		cell_cnt.resize(this->getGrid().size());
+		cell_cnt.fill(0);
+
+		// First pass: calculate the cells and count
+
+		fill_cells(pos,0,pos.size(),g_m,opt,cell_keys);
+
+		for (size_t i = 0 ; i < pos.size() ; i++)
+			cell_cnt.get(cell_keys.get(i))++;
+
+		Mem_type::init_to_count(cell_cnt);
+
+		// Second pass: scatter
+
+		part_slot.resize(pos.size());
+
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{
+			part_slot.get(i) = Mem_type::getNelements(cell_keys.get(i));
+			Mem_type::addCell(cell_keys.get(i),i);
+		}
+	}
+
+	/*! \brief Fill the cell-list when the memory is sparse (see fill)
+	 *
+	 * Same two passes of fill_impl, but the particles are counted directly in the sparse
+	 * structure, so nothing is allocated for the empty cells
+	 *
+	 * \param pos vector of positions
+	 * \param g_m marker
+	 * \param opt option like CL_SYMMETRIC or CL_NON_SYMMETRIC
+	 *
+	 */
+	void fill_sparse(const openfpm::vector<Point<dim,T>> & pos, size_t g_m, size_t opt, std::true_type)
+	{
+		cell_keys.resize(pos.size());
+
+		// First pass: calculate the cells and count
+
+		fill_cells(pos,0,pos.size(),g_m,opt,cell_keys);
+
+		Mem_type::clear();
+
+		for (size_t i = 0 ; i < pos.size() ; i++)
+			Mem_type::addCount(cell_keys.get(i));
+
+		Mem_type::init_from_count();
+
+		// Second pass: scatter
+
+		part_slot.resize(pos.size());
+
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{
+			part_slot.get(i) = Mem_type::getNelements(cell_keys.get(i));
+			Mem_type::addCell(cell_keys.get(i),i);
+		}
+	}
+
+	/*! \brief Fill the cell-list when the memory is dense (see fill)
+	 *
+	 * \param pos vector of positions
+	 * \param g_m marker
+	 * \param opt option like CL_SYMMETRIC or CL_NON_SYMMETRIC
+	 *
+	 */
+	void fill_sparse(const openfpm::vector<Point<dim,T>> & pos, size_t g_m, size_t opt, std::false_type)
+	{
+		fill_impl(pos,g_m,opt,std::integral_constant<bool,has_set_n_elements<Mem_type>::value>());
+	}
+
+	/*! \brief Fill the cell-list with multiple threads (see fill)
+	 *
+	 * The particles are divided in contiguous chunks one for each thread. Each thread
+	 * count the particles of its chunk for each cell, the counters of all the threads are
+	 * merged calculating for each cell and thread the position where the thread start to write.
+	 * Because the chunks are ordered, the result is identical to the serial construction
+	 * and no atomic operation is needed.
+	 *
+	 * \note the counters require n_thread * n_cells elements, the number of threads
+	 *       set with setNThreads is reduced to keep them at most twice the number of particles
+	 *
+	 * \param pos vector of positions
+	 * \param g_m marker
+	 * \param opt option like CL_SYMMETRIC or CL_NON_SYMMETRIC
+	 *
+	 */
+	void fill_impl(const openfpm::vector<Point<dim,T>> & pos, size_t g_m, size_t opt, std::true_type)
+	{
+#ifdef _OPENMP
+
+		size_t n_cell = this->getGrid().size();
+		size_t n_thr_max = 1 + 2*pos.size() / n_cell;
+		size_t n_thr = (this->n_thr > n_thr_max)?n_thr_max:this->n_thr;
+
+		if (n_thr <= 1)
+		{
+			fill_impl(pos,g_m,opt,std::false_type());
+			return;
+		}
+
+		cell_keys.resize(pos.size());
+		part_slot.resize(pos.size());
+		cell_cnt.resize(n_cell);
+		thr_cnt.resize(n_thr * n_cell);
+
+		#pragma omp parallel num_threads(n_thr)
+		{
+			size_t t = omp_get_thread_num();
+			size_t nt = omp_get_num_threads();
+
+			size_t start = pos.size() * t / nt;
+			size_t stop = pos.size() * (t+1) / nt;
+
+			typename Mem_type::loc_index * cnt = &thr_cnt.get(t*n_cell);
+
+			for (size_t c = 0 ; c < n_cell ; c++)
+				cnt[c] = 0;
+
+			// First pass: calculate the cells and count
+
+			fill_cells(pos,start,stop,g_m,opt,cell_keys);
+
+			for (size_t i = start ; i < stop ; i++)
+				cnt[cell_keys.get(i)]++;
+
+			#pragma omp barrier
+
+			// Merge, the counter of each thread become the starting point inside the cell
+
+			#pragma omp for
+			for (size_t c = 0 ; c < n_cell ; c++)
+			{
+				typename Mem_type::loc_index sum = 0;
+
+				for (size_t k = 0 ; k < nt ; k++)
+				{
+					typename Mem_type::loc_index tmp = thr_cnt.get(k*n_cell + c);
+					thr_cnt.get(k*n_cell + c) = sum;
+					sum += tmp;
+				}
+
+				cell_cnt.get(c) = sum;
+			}
+
+			#pragma omp single
+			Mem_type::init_to_count(cell_cnt);
+
+			// Second pass: scatter
+
+			for (size_t i = start ; i < stop ; i++)
+			{
+				size_t cell_id = cell_keys.get(i);
+
+				part_slot.get(i) = cnt[cell_id];
+				Mem_type::get(cell_id,cnt[cell_id]++) = i;
+			}
+		}
+
+		Mem_type::set_n_elements(cell_cnt);
+
+#else
+
+		fill_impl(pos,g_m,opt,std::false_type());
+
+#endif
+	}
+
+	/*! \brief Move a particle in another cell (see update)
+	 *
+	 * The last particle of the old cell take the place of the moved particle
+	 *
+	 * \param i particle
+	 * \param new_cell cell where to move the particle
+	 *
+	 */
+	inline void move_part(size_t i, size_t new_cell)
+	{
+		size_t old_cell = cell_keys.get(i);
+		size_t s = part_slot.get(i);
+		size_t last = Mem_type::getNelements(old_cell) - 1;
+
+		typename Mem_type::loc_index l = Mem_type::get(old_cell,last);
+		Mem_type::get(old_cell,s) = l;
+		part_slot.get(l) = s;
+		Mem_type::remove(old_cell,last);
+
+		part_slot.get(i) = Mem_type::getNelements(new_cell);
+		Mem_type::addCell(new_cell,i);
+		cell_keys.get(i) = new_cell;
+	}
+
 	void setCellDecomposer(CellDecomposer_sm<dim,T,transform> & cd, const CellDecomposer_sm<dim,T,transform> & cd_sm, const Box<dim,T> & dom_box, size_t pad) const
 	{
 		size_t bc[dim];
@@ -498,19 +790,19 @@ public:
 	//! Default Constructor
 	CellList()
 
-	:Mem_type(STARTING_NSLOT)
+	:Mem_type(STARTING_NSLOT),inc_ready(false),n_thr(1)
 	{};
 
 	//! Copy constructor
 	CellList(const CellList<dim,T,Mem_type,transform,base> & cell)
-	:Mem_type(STARTING_NSLOT)
+	:CellDecomposer_sm<dim,T,transform>(),Mem_type(STARTING_NSLOT),inc_ready(false),n_thr(1)
 	{
 		this->operator=(cell);
 	}
 
 	//! Copy constructor
 	CellList(CellList<dim,T,Mem_type,transform,base> && cell)
-	:Mem_type(STARTING_NSLOT)
+	:CellDecomposer_sm<dim,T,transform>(),Mem_type(STARTING_NSLOT),inc_ready(false),n_thr(1)
 	{
 		this->operator=(cell);
 	}
@@ -526,7 +818,7 @@ public:
 	 *
 	 */
 	CellList(Box<dim,T> & box, const size_t (&div)[dim], Matrix<dim,T> mat, const size_t pad = 1, size_t slot=STARTING_NSLOT)
-	:Mem_type(slot),CellDecomposer_sm<dim,T,transform>(box,div,mat,box.getP1(),pad)
+	:Mem_type(slot),CellDecomposer_sm<dim,T,transform>(box,div,mat,box.getP1(),pad),inc_ready(false),n_thr(1)
 	{
 		SpaceBox<dim,T> sbox(box);
 		Initialize(sbox,div,pad,slot);
@@ -541,7 +833,7 @@ public:
 	 *
 	 */
 	CellList(Box<dim,T> & box, const size_t (&div)[dim], const size_t pad = 1, size_t slot=STARTING_NSLOT)
-	:Mem_type(slot),n_dec(0)
+	:Mem_type(slot),n_dec(0),inc_ready(false),n_thr(1)
 	{
 		SpaceBox<dim,T> sbox(box);
 		Initialize(sbox,div,pad,slot);
@@ -556,7 +848,7 @@ public:
 	 *
 	 */
 	CellList(SpaceBox<dim,T> & box, const size_t (&div)[dim], const size_t pad = 1, size_t slot=STARTING_NSLOT)
-	:Mem_type(slot)
+	:Mem_type(slot),inc_ready(false),n_thr(1)
 	{
 		Initialize(box,div,pad,slot);
 	}
@@ -572,7 +864,7 @@ public:
 	 *
 	 */
 	CellList(CellDecomposer_sm<dim,T,transform> & cd_sm, const Box<dim,T> & box, const size_t pad = 1, size_t slot=STARTING_NSLOT)
-	:Mem_type(slot),n_dec(0)
+	:Mem_type(slot),n_dec(0),inc_ready(false),n_thr(1)
 	{
 		Initialize(cd_sm,box,pad,slot);
 	}
@@ -602,6 +894,9 @@ public:
 
 		n_dec = cell.n_dec;
 		from_cd = cell.from_cd;
+		n_thr = cell.n_thr;
+
+		inc_ready = false;
 
 		return *this;
 	}
@@ -624,6 +919,9 @@ public:
 
 		n_dec = cell.n_dec;
 		from_cd = cell.from_cd;
+		n_thr = cell.n_thr;
+
+		inc_ready = false;
 
 		return *this;
 	}
@@ -635,9 +933,9 @@ public:
 	 * \return a particle iterator
 	 *
 	 */
-	ParticleIt_Cells<dim,CellList<dim,T,Mem_fast<>,transform,base>> getDomainIterator(openfpm::vector<size_t> & dom_cells)
+	ParticleIt_Cells<dim,CellList<dim,T,Mem_type,transform,base>> getDomainIterator(openfpm::vector<size_t> & dom_cells)
 	{
-		ParticleIt_Cells<dim,CellList<dim,T,Mem_fast<>,transform,base>> it(*this,dom_cells);
+		ParticleIt_Cells<dim,CellList<dim,T,Mem_type,transform,base>> it(*this,dom_cells);
 
 		return it;
 	}
@@ -650,6 +948,8 @@ public:
 	 */
 	inline void addCell(size_t cell_id, typename base::value_type ele)
 	{
+		inc_ready = false;
+
 		Mem_type::addCell(cell_id,ele);
 	}
 
@@ -664,6 +964,8 @@ public:
 		// calculate the Cell id
 		size_t cell_id = this->getCell(pos);
 
+		inc_ready = false;
+
 		Mem_type::add(cell_id,ele);
 	}
 
@@ -678,6 +980,8 @@ public:
 		// calculate the Cell id
 		size_t cell_id = this->getCell(pos);
 
+		inc_ready = false;
+
 		Mem_type::add(cell_id,ele);
 	}
 
@@ -758,6 +1062,121 @@ public:
 		addCell(cell_id,ele);
 	}
 
+	/*! \brief Fill the cell-list with particles in two linear passes
+	 *
+	 * It is equivalent to clear() followed by add() (addDom()/addPad() in the symmetric case)
+	 * for each particle, and produce the same cell content in the same order. The first pass
+	 * calculate the cell of each particle and count the particles in each cell, the memory is
+	 * then sized from these counters, and the second pass scatter the particles into the cells.
+	 * In this way the internal structures are never reallocated while adding.
+	 *
+	 * When compiled with OpenMP, enabled with setNThreads and the memory structure can be written
+	 * directly (Mem_fast, Mem_compact) the construction is multi-threaded, see fill_impl
+	 * When the memory structure is sparse (Mem_sparse) the particles are counted directly in it,
+	 * see fill_sparse
+	 *
+	 * \param pos vector of positions
+	 * \param g_m marker (particle below this marker must be inside the domain, particles outside this marker must be outside the domain)
+	 * \param opt option like CL_SYMMETRIC or CL_NON_SYMMETRIC
+	 *
+	 */
+	void fill(const openfpm::vector<Point<dim,T>> & pos, size_t g_m, size_t opt = CL_NON_SYMMETRIC)
+	{
+		fill_sparse(pos,g_m,opt,std::integral_constant<bool,has_add_count<Mem_type>::value>());
+
+		inc_ready = true;
+		inc_g_m = g_m;
+		inc_opt = opt;
+	}
+
+	/*! \brief Set the maximum number of threads used by fill
+	 *
+	 * By default the construction is serial. The threads are used only when compiled
+	 * with OpenMP (see --enable-openmp), the number of threads is also limited by the team
+	 * size OpenMP allows
+	 *
+	 * \param n_thr number of threads (0 use omp_get_max_threads())
+	 *
+	 */
+	void setNThreads(size_t n_thr)
+	{
+#ifdef _OPENMP
+		if (n_thr == 0)
+			n_thr = omp_get_max_threads();
+#endif
+
+		this->n_thr = (n_thr == 0)?1:n_thr;
+	}
+
+	/*! \brief Get the maximum number of threads used by fill
+	 *
+	 * \return the number of threads
+	 *
+	 */
+	size_t getNThreads() const
+	{
+		return n_thr;
+	}
+
+	/*! \brief Update the cell-list after the particles moved
+	 *
+	 * The cell of each particle is calculated again and only the particles that changed cell
+	 * are moved. The Cell-list must have been constructed with fill() with the same g_m and opt
+	 * and the same number of particles, otherwise it is filled again from scratch.
+	 *
+	 * \note the order of the particles inside the cells is not preserved
+	 *
+	 * \param pos vector of positions
+	 * \param g_m marker
+	 * \param opt option like CL_SYMMETRIC or CL_NON_SYMMETRIC
+	 *
+	 */
+	void update(const openfpm::vector<Point<dim,T>> & pos, size_t g_m, size_t opt = CL_NON_SYMMETRIC)
+	{
+		if (inc_ready == false || pos.size() != cell_keys.size() || g_m != inc_g_m || opt != inc_opt)
+		{
+			fill(pos,g_m,opt);
+			return;
+		}
+
+		cell_keys_new.resize(pos.size());
+		fill_cells(pos,0,pos.size(),g_m,opt,cell_keys_new);
+
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{
+			if (cell_keys_new.get(i) != cell_keys.get(i))
+				move_part(i,cell_keys_new.get(i));
+		}
+	}
+
+	/*! \brief Update the cell-list after some particles moved
+	 *
+	 * Like update(pos,g_m,opt) but only the particles in the list are checked
+	 *
+	 * \param pos vector of positions
+	 * \param changed particles that moved
+	 * \param g_m marker
+	 * \param opt option like CL_SYMMETRIC or CL_NON_SYMMETRIC
+	 *
+	 */
+	void update(const openfpm::vector<Point<dim,T>> & pos, const openfpm::vector<size_t> & changed, size_t g_m, size_t opt = CL_NON_SYMMETRIC)
+	{
+		if (inc_ready == false || pos.size() != cell_keys.size() || g_m != inc_g_m || opt != inc_opt)
+		{
+			fill(pos,g_m,opt);
+			return;
+		}
+
+		for (size_t k = 0 ; k < changed.size() ; k++)
+		{
+			size_t i = changed.get(k);
+			size_t cell_id = fill_cell(pos,i,g_m,opt);
+
+			if (cell_id != cell_keys.get(i))
+				move_part(i,cell_id);
+		}
+	}
+
 	/*! \brief remove an element from the cell
 	 *
 	 * \param cell cell id
@@ -766,6 +1185,8 @@ public:
 	 */
 	inline void remove(size_t cell, size_t ele)
 	{
+		inc_ready = false;
+
 		Mem_type::remove(cell,ele);
 	}
 
@@ -824,6 +1245,13 @@ public:
 		Mem_type::swap(static_cast<Mem_type &>(cl));
 
 		static_cast<CellDecomposer_sm<dim,T,transform> &>(*this) = static_cast<const CellDecomposer_sm<dim,T,transform> &>(cl);
+
+		size_t n_thr_tmp = cl.n_thr;
+		cl.n_thr = n_thr;
+		n_thr = n_thr_tmp;
+
+		inc_ready = false;
+		cl.inc_ready = false;
 	}
 
 	/*! \brief Get the Cell iterator
@@ -838,6 +1266,50 @@ public:
 		return CellIterator<CellList<dim,T,Mem_type,transform,base>>(cell,*this);
 	}
 
+	/*! \brief Get an iterator across the domain cells grouped in cache-sized tiles
+	 *
+	 * The size of the tile is chosen from the average occupancy of the domain cells, so that
+	 * the particles of a tile and of its neighborhood (id and position) fit cache_size. Using it
+	 * in place of the linear order to select the center cells of a neighborhood sweep the
+	 * neighborhood cells are reused by the consecutive centers
+	 *
+	 * \snippet CellList_test.hpp Usage of tile iterator
+	 *
+	 * \param cache_size size of the cache to fit in bytes
+	 *
+	 * \return the iterator across the domain cells
+	 *
+	 */
+	CellTileIterator<dim> getTileIterator(size_t cache_size = CELL_TILE_CACHE_SIZE)
+	{
+		const grid_sm<dim,void> & gs = this->getGrid();
+
+		size_t n_dom = 1;
+		for (size_t i = 0 ; i < dim ; i++)
+			n_dom *= gs.size(i) - 2*this->getPadding(i);
+
+		size_t n_ele = 0;
+		for (size_t c = 0 ; c < gs.size() ; c++)
+			n_ele += this->getNelements(c);
+
+		size_t tile[dim];
+		CellTileIterator<dim>::calculateTile(gs,this->getPadding(),(double)n_ele / n_dom,sizeof(Point<dim,T>) + sizeof(typename Mem_type::loc_index),cache_size,tile);
+
+		return CellTileIterator<dim>(gs,this->getPadding(),tile);
+	}
+
+	/*! \brief Get an iterator across the domain cells grouped in tiles of a given size
+	 *
+	 * \param tile size of the tile in each direction
+	 *
+	 * \return the iterator across the domain cells
+	 *
+	 */
+	CellTileIterator<dim> getTileIterator(const size_t (& tile)[dim])
+	{
+		return CellTileIterator<dim>(this->getGrid(),this->getPadding(),tile);
+	}
+
 	/*! \brief Get the Neighborhood iterator
 	 *
 	 * It iterate across all the element of the selected cell and the near cells
@@ -865,6 +1337,37 @@ public:
 
 	}
 
+	/*! \brief Get the Neighborhood iterator for a periodic domain without ghost particles
+	 *
+	 * The neighborhood cells outside the domain are wrapped on the other side of the domain,
+	 * and the iterator return with the particle id the shift to apply to its position
+	 * (minimum image). The Cell-list must be filled only with the particles inside the domain
+	 * and have at least 3 divisions in each direction (checked, the error is reported with ACTION_ON_ERROR)
+	 *
+	 * \snippet CellList_test.hpp Usage of periodic NN iterator
+	 *
+	 * \param cell cell id (domain cell)
+	 *
+	 * \return An iterator across the neighborhood particles and their shift
+	 *
+	 */
+	template<unsigned int impl=NO_CHECK> inline CellNNIteratorPeriodic<dim,CellList<dim,T,Mem_type,transform,base>,impl> getNNIteratorPeriodic(size_t cell)
+	{
+		// with less than 3 divisions the wrapped neighborhood cells overlap and the same
+		// particle is visited more than one time
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			if (this->getGrid().size(i) < 3 + 2*this->getPadding(i))
+			{
+				std::cerr << "Error " << __FILE__ << ":" << __LINE__ << " the periodic neighborhood iterator require at least 3 divisions (padding excluded) in each direction, direction " << i << " has " << this->getGrid().size(i) - 2*this->getPadding(i) << "\n";
+				ACTION_ON_ERROR(CELL_DECOMPOSER);
+			}
+		}
+
+		CellNNIteratorPeriodic<dim,CellList<dim,T,Mem_type,transform,base>,impl> cln(cell,*this);
+		return cln;
+	}
+
 	/*! \brief Get the symmetric Neighborhood iterator
 	 *
 	 * It iterate across all the element of the selected cell and the near cells up to some selected radius
@@ -887,6 +1390,188 @@ public:
 		return cln;
 	}
 
+private:
+
+	/*! \brief Search the k nearest particles of a point (see getKNN)
+	 *
+	 * The cells are visited in shells of increasing distance (in cells) from the cell of xp.
+	 * After the shell s every particle not visited is at least s cells far, so the search stop
+	 * when k particles are found and the farthest of them is closer than that.
+	 *
+	 * \param pos particle positions
+	 * \param xp point
+	 * \param k number of neighborhood
+	 * \param skip particle to exclude (pos.size() to exclude nothing)
+	 * \param heap bounded max-heap of (square distance,id), at the end it contain the neighborhood
+	 *        sorted by distance
+	 *
+	 */
+	void getKNN_impl(const openfpm::vector<Point<dim,T>> & pos, const Point<dim,T> & xp, size_t k, size_t skip, openfpm::vector<std::pair<T,size_t>> & heap)
+	{
+		heap.clear();
+
+		if (k == 0)
+			return;
+
+		const grid_sm<dim,void> & gs = this->getGrid();
+		grid_key_dx<dim> kc = this->getCellGrid(xp);
+
+		for (long int s = 0 ; ; s++)
+		{
+			grid_key_dx<dim> start;
+			grid_key_dx<dim> stop;
+
+			// distance from xp of the particles that are not yet visited
+			T bound = std::numeric_limits<T>::max();
+			bool all = true;
+
+			for (size_t i = 0 ; i < dim ; i++)
+			{
+				long int st = kc.get(i) - s;
+				long int sp = kc.get(i) + s;
+
+				if (st > 0 || sp < (long int)gs.size(i) - 1)
+				{
+					all = false;
+
+					T b = s * this->getCellBox().getHigh(i);
+					bound = (b < bound)?b:bound;
+				}
+
+				start.set_d(i,(st < 0)?0:st);
+				stop.set_d(i,(sp >= (long int)gs.size(i))?gs.size(i)-1:sp);
+			}
+
+			grid_key_dx_iterator_sub<dim> it(gs,start,stop);
+
+			while (it.isNext())
+			{
+				auto key = it.get();
+
+				// only the cells of the shell s
+				long int d = 0;
+				for (size_t i = 0 ; i < dim ; i++)
+				{
+					long int di = key.get(i) - kc.get(i);
+					di = (di < 0)?-di:di;
+					d = (di > d)?di:d;
+				}
+
+				if (d == s)
+				{
+					size_t c = gs.LinId(key);
+
+					const typename Mem_type::loc_index * q = &this->getStartId(c);
+					const typename Mem_type::loc_index * q_stop = &this->getStopId(c);
+
+					for ( ; q != q_stop ; q++)
+					{
+						size_t id = this->get_lin(q);
+
+						if (id == skip)
+							continue;
+
+						Point<dim,T> xq = pos.template get<0>(id);
+						std::pair<T,size_t> e(xq.distance2(xp),id);
+
+						if (heap.size() < k)
+						{
+							heap.add(e);
+							std::push_heap(&heap.get(0),&heap.get(0) + heap.size());
+						}
+						else if (e < heap.get(0))
+						{
+							std::pop_heap(&heap.get(0),&heap.get(0) + heap.size());
+							heap.last() = e;
+							std::push_heap(&heap.get(0),&heap.get(0) + heap.size());
+						}
+					}
+				}
+
+				++it;
+			}
+
+			if (all == true || (heap.size() == k && heap.get(0).first <= bound*bound))
+				break;
+		}
+
+		if (heap.size() != 0)
+			std::sort_heap(&heap.get(0),&heap.get(0) + heap.size());
+	}
+
+public:
+
+	/*! \brief Get the k nearest particles of a point
+	 *
+	 * The cells are expanded in shells around the cell of the point and the search stop as soon
+	 * as no particle outside the visited cells can be closer than the k-th found
+	 *
+	 * \note as for the other queries the particles must be inside the cell space (domain + padding)
+	 *
+	 * \param pos particle positions (the Cell-list must be filled with them)
+	 * \param xp point
+	 * \param k number of neighborhood
+	 * \param out_ids id of the k nearest particles sorted by distance (less than k if the
+	 *        Cell-list has less than k particles)
+	 * \param out_dist2 square distance of the k nearest particles
+	 *
+	 */
+	void getKNN(const openfpm::vector<Point<dim,T>> & pos, const Point<dim,T> & xp, size_t k, openfpm::vector<size_t> & out_ids, openfpm::vector<T> & out_dist2)
+	{
+		openfpm::vector<std::pair<T,size_t>> heap;
+
+		getKNN_impl(pos,xp,k,pos.size(),heap);
+
+		out_ids.resize(heap.size());
+		out_dist2.resize(heap.size());
+
+		for (size_t j = 0 ; j < heap.size() ; j++)
+		{
+			out_dist2.get(j) = heap.get(j).first;
+			out_ids.get(j) = heap.get(j).second;
+		}
+	}
+
+	/*! \brief Get the k nearest particles of every particle (the particle itself excluded)
+	 *
+	 * The heap is allocated one time and reused for all the queries
+	 *
+	 * \param pos particle positions (the Cell-list must be filled with them)
+	 * \param k number of neighborhood
+	 * \param out_ids k*pos.size() ids, the neighborhood of p are in [k*p,k*(p+1)) sorted by distance,
+	 *        if p has less than k neighborhood the remaining slots are set to KNN_NO_PARTICLE
+	 * \param out_dist2 k*pos.size() square distances (std::numeric_limits<T>::max() in the
+	 *        slots not filled)
+	 *
+	 */
+	void getKNN_all(const openfpm::vector<Point<dim,T>> & pos, size_t k, openfpm::vector<size_t> & out_ids, openfpm::vector<T> & out_dist2)
+	{
+		openfpm::vector<std::pair<T,size_t>> heap;
+		heap.reserve(k);
+
+		out_ids.resize(k*pos.size());
+		out_dist2.resize(k*pos.size());
+
+		for (size_t p = 0 ; p < pos.size() ; p++)
+		{
+			Point<dim,T> xp = pos.template get<0>(p);
+
+			getKNN_impl(pos,xp,k,p,heap);
+
+			for (size_t j = 0 ; j < heap.size() ; j++)
+			{
+				out_dist2.get(k*p + j) = heap.get(j).first;
+				out_ids.get(k*p + j) = heap.get(j).second;
+			}
+
+			for (size_t j = heap.size() ; j < k ; j++)
+			{
+				out_dist2.get(k*p + j) = std::numeric_limits<T>::max();
+				out_ids.get(k*p + j) = KNN_NO_PARTICLE;
+			}
+		}
+	}
+
 
 
 	/*! \brief Get the symmetric Neighborhood iterator
@@ -957,6 +1642,16 @@ public:
 		return cln;
 	}
 
+	/*! \brief Get the full neighborhood
+	 *
+	 * \return the full neighborhood
+	 *
+	 */
+	const NNc_array<dim,(unsigned int)openfpm::math::pow(3,dim)> & getNNc_full() const
+	{
+		return NNc_full;
+	}
+
 	/*! \brief Get the symmetric neighborhood
 	 *
 	 * \return the symmetric neighborhood
@@ -995,6 +1690,8 @@ public:
 	 */
 	void clear()
 	{
+		inc_ready = false;
+
 		Mem_type::clear();
 	}
 
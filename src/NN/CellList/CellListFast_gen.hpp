@@ -29,7 +29,7 @@ template<unsigned int dim,
 		 template <unsigned int, typename> class Prock,
 		 typename Mem_type = Mem_fast<>,
 		 typename transform = no_transform<dim,T>,
-		 typename base=openfpm::vector<size_t>>
+		 typename base=openfpm::vector<typename Mem_type::loc_index>>
 class CellList_gen : public CellList<dim,T,Mem_type,transform,base>
 {
 private:
@@ -160,6 +160,62 @@ public:
 		return SFC.getKeys();
 	}
 
+	/*! \brief Get the permutation that order the particles following the space-filling-curve
+	 *
+	 * The particles are ordered as the cells are visited by the space-filling-curve. Domain
+	 * particles remain before the ghost marker and ghost particles after, the particles that are
+	 * in the padding cells are at the end of their group in the original order
+	 *
+	 * \param n_part number of particles in the cell-list
+	 * \param g_m ghost marker
+	 * \param perm permutation (perm.get(i) is the old id of the particle that go in position i)
+	 *
+	 */
+	void getSFCPermutation(size_t n_part, size_t g_m, openfpm::vector<size_t> & perm)
+	{
+		init_SFC();
+
+		openfpm::vector<size_t> gh;
+		std::vector<bool> done(n_part,false);
+
+		perm.clear();
+
+		const openfpm::vector<size_t> & keys = SFC.getKeys();
+
+		for (size_t i = 0 ; i < keys.size() ; i++)
+		{
+			size_t cell = keys.get(i);
+
+			for (size_t j = 0 ; j < this->getNelements(cell) ; j++)
+			{
+				size_t p = this->get(cell,j);
+
+				if (p < g_m)
+					perm.add(p);
+				else
+					gh.add(p);
+
+				done[p] = true;
+			}
+		}
+
+		// particles in the padding cells
+
+		for (size_t p = 0 ; p < n_part ; p++)
+		{
+			if (done[p] == true)
+				continue;
+
+			if (p < g_m)
+				perm.add(p);
+			else
+				gh.add(p);
+		}
+
+		for (size_t i = 0 ; i < gh.size() ; i++)
+			perm.add(gh.get(i));
+	}
+
 	/*! \brief return the ghost marker
 	 *
 	 * \return ghost marker
@@ -180,4 +236,48 @@ public:
 	}
 };
 
+/*! \brief Apply a permutation to a set of vectors
+ *
+ * \param perm permutation
+ *
+ */
+inline void permute_vectors(const openfpm::vector<size_t> & perm)
+{}
+
+/*! \brief Apply a permutation to a set of vectors
+ *
+ * \param perm permutation
+ * \param v vector to reorder
+ * \param vs other vectors to reorder
+ *
+ */
+template<typename vector, typename ... vectors> inline void permute_vectors(const openfpm::vector<size_t> & perm, vector & v, vectors & ... vs)
+{
+	v.permute(perm);
+	permute_vectors(perm,vs...);
+}
+
+/*! \brief Reorder the particles following the space-filling-curve of the Cell-list
+ *
+ * Particles in neighborhood cells become near in memory, so the traversal of the
+ * Cell-list (or of a Verlet-list constructed on it) access the particles data
+ * almost sequentially
+ *
+ * \param cl Cell-list filled with the particles pos
+ * \param g_m ghost marker
+ * \param perm output permutation (perm.get(i) is the old id of the particle that is now in position i)
+ * \param pos vector of positions
+ * \param prp vectors of properties to reorder with the positions (any layout)
+ *
+ * \note the Cell-list is not updated, it must be filled again with the reordered positions
+ *
+ */
+template<typename CellList_type, typename vector_pos, typename ... vector_prp>
+void reorder_sfc(CellList_type & cl, size_t g_m, openfpm::vector<size_t> & perm, vector_pos & pos, vector_prp & ... prp)
+{
+	cl.getSFCPermutation(pos.size(),g_m,perm);
+
+	permute_vectors(perm,pos,prp...);
+}
+
 #endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLLISTFAST_GEN_HPP_ */
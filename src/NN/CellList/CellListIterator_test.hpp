@@ -463,6 +463,112 @@ BOOST_AUTO_TEST_CASE( ParticleIt_Cells_iterator )
 	BOOST_REQUIRE_EQUAL(count,290ul);
 }
 
+/*! \brief Test the reordering of the particles following the cell-list space-filling-curve
+ *
+ * \tparam Prock space-filling-curve
+ * \tparam Mem_type memory type of the cell-list
+ *
+ */
+template<template <unsigned int, typename> class Prock, typename Mem_type = Mem_fast<>> void Test_reorder_sfc()
+{
+	const size_t dim = 3;
+
+	size_t div[dim] = {8,8,8};
+
+	Box<dim,float> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+
+	CellList_gen<dim,float,Prock,Mem_type> NN;
+
+	NN.Initialize(box,div,1);
+
+	openfpm::vector<Point<dim,float>> pos;
+	openfpm::vector<aggregate<size_t,float[dim]>> prp_aos;
+	openfpm::vector<aggregate<size_t,float[dim]>,HeapMemory,typename memory_traits_inte<aggregate<size_t,float[dim]>>::type,memory_traits_inte> prp_soa;
+
+	size_t k = 2000;
+	size_t g_m = k*0.9;
+
+	for (size_t i = 0 ; i < k ; i++)
+	{
+		Point<dim,float> p;
+
+		for (size_t j = 0 ; j < dim ; j++)
+			p.get(j) = rand()/double(RAND_MAX);
+
+		pos.add(p);
+		prp_aos.add();
+		prp_soa.add();
+
+		prp_aos.template get<0>(i) = i;
+		prp_soa.template get<0>(i) = i;
+
+		for (size_t j = 0 ; j < dim ; j++)
+		{
+			prp_aos.template get<1>(i)[j] = p.get(j);
+			prp_soa.template get<1>(i)[j] = p.get(j);
+		}
+	}
+
+	openfpm::vector<Point<dim,float>> pos_old = pos;
+
+	NN.fill(pos,g_m,CL_NON_SYMMETRIC);
+
+	openfpm::vector<size_t> perm;
+
+	reorder_sfc(NN,g_m,perm,pos,prp_aos,prp_soa);
+
+	BOOST_REQUIRE_EQUAL(perm.size(),k);
+
+	std::vector<bool> found(k,false);
+
+	for (size_t i = 0 ; i < k ; i++)
+	{
+		size_t o = perm.get(i);
+
+		BOOST_REQUIRE_EQUAL(found[o],false);
+		found[o] = true;
+
+		// domain particles remain domain particles
+		BOOST_REQUIRE_EQUAL(i < g_m,o < g_m);
+
+		BOOST_REQUIRE_EQUAL(prp_aos.template get<0>(i),o);
+		BOOST_REQUIRE_EQUAL(prp_soa.template get<0>(i),o);
+
+		for (size_t j = 0 ; j < dim ; j++)
+		{
+			BOOST_REQUIRE_EQUAL(pos.template get<0>(i)[j],pos_old.template get<0>(o)[j]);
+			BOOST_REQUIRE_EQUAL(prp_aos.template get<1>(i)[j],pos_old.template get<0>(o)[j]);
+			BOOST_REQUIRE_EQUAL(prp_soa.template get<1>(i)[j],pos_old.template get<0>(o)[j]);
+		}
+	}
+
+	// After the reordering the iteration across the cells is sequential in memory
+
+	NN.fill(pos,g_m,CL_NON_SYMMETRIC);
+	NN.set_gm(g_m);
+
+	auto it_cl = NN.getIterator();
+
+	size_t count = 0;
+
+	while (it_cl.isNext())
+	{
+		BOOST_REQUIRE_EQUAL(it_cl.get(),count);
+
+		count++;
+		++it_cl;
+	}
+
+	BOOST_REQUIRE_EQUAL(count,g_m);
+}
+
+BOOST_AUTO_TEST_CASE( celllist_sfc_reorder_test )
+{
+	Test_reorder_sfc<Process_keys_lin>();
+	Test_reorder_sfc<Process_keys_hilb>();
+	Test_reorder_sfc<Process_keys_lin,Mem_fast<unsigned int>>();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLLISTITERATOR_TEST_HPP_ */
@@ -56,7 +56,7 @@ class CellListM : public CellBase
 	typedef boost::high_bit_mask_t<sh_byte>  mask_high;
 
 	//! Mask to get the low bits of a number
-	typedef boost::low_bits_mask_t<sizeof(size_t)*8-sh_byte>  mask_low;
+	typedef boost::low_bits_mask_t<sizeof(typename CellBase::Mem_type_type::loc_index)*8-sh_byte>  mask_low;
 
 public:
 
@@ -130,7 +130,7 @@ public:
 	 */
 	inline void addCell(size_t cell_id, size_t ele, size_t v_id)
 	{
-		size_t ele_k = ele | (v_id << (sizeof(size_t)*8-sh_byte));
+		size_t ele_k = ele | (v_id << (sizeof(typename CellBase::Mem_type_type::loc_index)*8-sh_byte));
 
 		CellBase::addCell(cell_id,ele_k);
 	}
@@ -147,7 +147,7 @@ public:
 		// calculate the Cell id
 
 		size_t cell_id = this->getCell(pos);
-		size_t ele_k = ele | (v_id << (sizeof(size_t)*8-sh_byte));
+		size_t ele_k = ele | (v_id << (sizeof(typename CellBase::Mem_type_type::loc_index)*8-sh_byte));
 
 		// add the element to the cell
 
@@ -166,7 +166,7 @@ public:
 		// calculate the Cell id
 
 		size_t cell_id = this->getCell(pos);
-		size_t ele_k = ele | (v_id << (sizeof(size_t)*8-sh_byte));
+		size_t ele_k = ele | (v_id << (sizeof(typename CellBase::Mem_type_type::loc_index)*8-sh_byte));
 
 		// add the element to the cell
 
@@ -194,7 +194,7 @@ public:
 	 */
 	static inline size_t getV(size_t ele)
 	{
-		return ele >> (sizeof(size_t)*8-sh_byte);
+		return ele >> (sizeof(typename CellBase::Mem_type_type::loc_index)*8-sh_byte);
 	}
 
 	/*! \brief Get the element-id in the cell
@@ -224,7 +224,7 @@ public:
 	 */
 	inline size_t getV(size_t cell, size_t ele)
 	{
-		return (CellBase::get(cell,ele)) >> (sizeof(size_t)*8-sh_byte);
+		return (CellBase::get(cell,ele)) >> (sizeof(typename CellBase::Mem_type_type::loc_index)*8-sh_byte);
 	}
 
 	/*! \brief Swap the memory
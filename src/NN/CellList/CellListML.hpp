@@ -0,0 +1,247 @@
+/*
+ * CellListML.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_CELLLISTML_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_CELLLISTML_HPP_
+
+#include "CellList.hpp"
+#include <cmath>
+
+/*! \brief Multi-level Cell-list for particles with different cut-off radius
+ *
+ * The Cell-list is a stack of Cell-lists on the same box, level 0 is the finest and every level
+ * has half of the divisions of the previous one (factor-2 refinement).
+ * Each particle is stored in the finest level with a cell bigger or equal to its cut-off
+ * radius (or in the coarsest if no level is big enough), so big particles does not force a
+ * coarse grid on the small one and small particles does not force big particles to
+ * visit a huge number of fine cells.
+ *
+ * A neighborhood query from a particle with radius r visit, on each level, the cells
+ * that intersect the ball of radius max(r,r_l), where r_l is the biggest radius stored
+ * in the level. It mean that every particle q with |x_p - x_q| < max(r_p,r_q) is visited.
+ * Levels without particles are skipped.
+ *
+ * \note to have exactly the factor 2 between the levels the divisions of the finest level
+ *       should be divisible by 2^(n_lev-1)
+ *
+ * \tparam dim dimensionality
+ * \tparam T type of space
+ * \tparam Mem_type memory type of each level
+ *
+ */
+template<unsigned int dim, typename T, typename Mem_type = Mem_fast<>>
+class CellListML
+{
+	//! Cell-list of each level
+	openfpm::vector<CellList<dim,T,Mem_type>> lev;
+
+	//! biggest radius stored in each level
+	openfpm::vector<T> r_max;
+
+	//! number of particles stored in each level
+	openfpm::vector<size_t> n_part;
+
+	//! size of the cell in each level (minimum across the dimensions)
+	openfpm::vector<T> h_min;
+
+public:
+
+	/*! \brief Initialize the multi-level Cell-list
+	 *
+	 * \param box Domain where this cell list is living
+	 * \param div number of divisions of the finest level
+	 * \param n_lev number of levels
+	 * \param pad padding cell
+	 *
+	 */
+	void Initialize(const Box<dim,T> & box, const size_t (&div)[dim], size_t n_lev, const size_t pad = 1)
+	{
+		lev.resize(n_lev);
+		r_max.resize(n_lev);
+		n_part.resize(n_lev);
+		h_min.resize(n_lev);
+
+		for (size_t l = 0 ; l < n_lev ; l++)
+		{
+			size_t div_l[dim];
+
+			for (size_t i = 0 ; i < dim ; i++)
+			{
+				div_l[i] = div[i] >> l;
+				div_l[i] = (div_l[i] == 0)?1:div_l[i];
+			}
+
+			lev.get(l).Initialize(box,div_l,pad);
+
+			h_min.get(l) = std::numeric_limits<T>::max();
+			for (size_t i = 0 ; i < dim ; i++)
+			{
+				T h = lev.get(l).getCellBox().getHigh(i);
+				h_min.get(l) = (h < h_min.get(l))?h:h_min.get(l);
+			}
+
+			r_max.get(l) = 0;
+			n_part.get(l) = 0;
+		}
+	}
+
+	/*! \brief Return the number of levels
+	 *
+	 * \return the number of levels
+	 *
+	 */
+	size_t getNLevels() const
+	{
+		return lev.size();
+	}
+
+	/*! \brief Get the Cell-list of a level
+	 *
+	 * \param l level
+	 *
+	 * \return the Cell-list of the level l
+	 *
+	 */
+	CellList<dim,T,Mem_type> & getLevel(size_t l)
+	{
+		return lev.get(l);
+	}
+
+	/*! \brief Get the number of particles stored in a level
+	 *
+	 * \param l level
+	 *
+	 * \return the number of particles
+	 *
+	 */
+	size_t getNParticles(size_t l) const
+	{
+		return n_part.get(l);
+	}
+
+	/*! \brief Return the level where a particle with cut-off radius r is stored
+	 *
+	 * \param r cut-off radius
+	 *
+	 * \return the finest level with cells bigger or equal to r (the coarsest if none)
+	 *
+	 */
+	size_t selectLevel(T r) const
+	{
+		for (size_t l = 0 ; l < h_min.size() ; l++)
+		{
+			if (h_min.get(l) >= r)
+				return l;
+		}
+
+		return h_min.size() - 1;
+	}
+
+	/*! \brief Add a particle
+	 *
+	 * \param pos position of the particle
+	 * \param r cut-off radius of the particle
+	 * \param ele element to store
+	 *
+	 */
+	void add(const Point<dim,T> & pos, T r, size_t ele)
+	{
+		size_t l = selectLevel(r);
+
+		lev.get(l).add(pos,ele);
+
+		r_max.get(l) = (r > r_max.get(l))?r:r_max.get(l);
+		n_part.get(l)++;
+	}
+
+	/*! \brief Clear all the levels
+	 *
+	 */
+	void clear()
+	{
+		for (size_t l = 0 ; l < lev.size() ; l++)
+		{
+			lev.get(l).clear();
+			r_max.get(l) = 0;
+			n_part.get(l) = 0;
+		}
+	}
+
+	/*! \brief Fill the multi-level Cell-list
+	 *
+	 * \param pos particle positions
+	 * \param r cut-off radius of each particle
+	 *
+	 */
+	void fill(const openfpm::vector<Point<dim,T>> & pos, const openfpm::vector<T> & r)
+	{
+		clear();
+
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{
+			Point<dim,T> xp = pos.template get<0>(i);
+			add(xp,r.get(i),i);
+		}
+	}
+
+	/*! \brief Call a functor on every candidate neighborhood of a point
+	 *
+	 * For each level the functor is called on all the particles in the cells intersecting
+	 * the ball of radius max(r,r_l) around xp (r_l biggest radius of the level). The functor
+	 * receive the element stored (f(size_t q)) and must filter the candidates by distance
+	 *
+	 * \param xp position
+	 * \param r cut-off radius of the query
+	 * \param f functor
+	 *
+	 */
+	template<typename Functor> void forEachNN(const Point<dim,T> & xp, T r, Functor f)
+	{
+		for (size_t l = 0 ; l < lev.size() ; l++)
+		{
+			if (n_part.get(l) == 0)
+				continue;
+
+			CellList<dim,T,Mem_type> & cl = lev.get(l);
+			const grid_sm<dim,void> & gs = cl.getGrid();
+
+			T R = (r > r_max.get(l))?r:r_max.get(l);
+
+			grid_key_dx<dim> k = cl.getCellGrid(xp);
+			grid_key_dx<dim> start;
+			grid_key_dx<dim> stop;
+
+			for (size_t i = 0 ; i < dim ; i++)
+			{
+				long int n = std::ceil(R / cl.getCellBox().getHigh(i));
+
+				long int s = k.get(i) - n;
+				long int e = k.get(i) + n;
+
+				start.set_d(i,(s < 0)?0:s);
+				stop.set_d(i,(e >= (long int)gs.size(i))?gs.size(i)-1:e);
+			}
+
+			grid_key_dx_iterator_sub<dim> it(gs,start,stop);
+
+			while (it.isNext())
+			{
+				size_t c = gs.LinId(it.get());
+
+				const typename Mem_type::loc_index * q = &cl.getStartId(c);
+				const typename Mem_type::loc_index * q_stop = &cl.getStopId(c);
+
+				for ( ; q != q_stop ; q++)
+					f(cl.get_lin(q));
+
+				++it;
+			}
+		}
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLLISTML_HPP_ */
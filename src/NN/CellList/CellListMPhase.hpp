@@ -0,0 +1,205 @@
+/*
+ * CellListMPhase.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_CELLLISTMPHASE_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_CELLLISTMPHASE_HPP_
+
+#include "CellList.hpp"
+#include "CellNNIteratorMPhase.hpp"
+
+/*! \brief Multi-phase Cell-list without bit-packing
+ *
+ * Unlike CellListM the phase is not packed in the high bits of the stored element, every
+ * phase has its own Cell-list on the same grid. The cell c of the phase v is the contiguous
+ * range getPhase(v).getStartId(c) - getPhase(v).getStopId(c), so the number of phases and the
+ * number of particles of each phase are not limited by sh_byte and the particle id is read
+ * without masking.
+ *
+ * \snippet CellList_test.hpp Usage of CellListMPhase
+ *
+ * \tparam dim dimensionality
+ * \tparam T type of space
+ * \tparam CellBase Cell-list used for each phase
+ *
+ */
+template<unsigned int dim, typename T, typename CellBase=CellList<dim,T,Mem_fast<>,shift<dim,T>>>
+class CellListMPhase
+{
+	//! Cell-list of each phase
+	openfpm::vector<CellBase> ph;
+
+public:
+
+	//! Type of the memory of each phase
+	typedef typename CellBase::Mem_type_type Mem_type_type;
+
+	//! Type of the space
+	typedef T stype;
+
+	/*! \brief Initialize the multi-phase Cell-list
+	 *
+	 * \param box Domain where this cell list is living
+	 * \param div number of division for each dimension
+	 * \param n_phase number of phases
+	 * \param pad padding cell
+	 * \param slot maximum number of slot
+	 *
+	 */
+	void Initialize(const Box<dim,T> & box, const size_t (&div)[dim], size_t n_phase, const size_t pad = 1, size_t slot=STARTING_NSLOT)
+	{
+		ph.resize(n_phase);
+
+		for (size_t v = 0 ; v < n_phase ; v++)
+			ph.get(v).Initialize(box,div,pad,slot);
+	}
+
+	/*! \brief Return the number of phases
+	 *
+	 * \return the number of phases
+	 *
+	 */
+	inline size_t getNPhases() const
+	{
+		return ph.size();
+	}
+
+	/*! \brief Get the Cell-list of one phase
+	 *
+	 * \param v phase
+	 *
+	 * \return the Cell-list of the phase v
+	 *
+	 */
+	inline CellBase & getPhase(size_t v)
+	{
+		return ph.get(v);
+	}
+
+	/*! \brief Get the Cell-list of one phase
+	 *
+	 * \param v phase
+	 *
+	 * \return the Cell-list of the phase v
+	 *
+	 */
+	inline const CellBase & getPhase(size_t v) const
+	{
+		return ph.get(v);
+	}
+
+	/*! \brief Get the cell-id of a position (all the phases share the same grid)
+	 *
+	 * \param pos position
+	 *
+	 * \return the cell-id
+	 *
+	 */
+	inline size_t getCell(const Point<dim,T> & pos) const
+	{
+		return ph.get(0).getCell(pos);
+	}
+
+	/*! \brief Get the cell unit box
+	 *
+	 * \return the cell box
+	 *
+	 */
+	inline const Box<dim,T> & getCellBox() const
+	{
+		return ph.get(0).getCellBox();
+	}
+
+	/*! \brief Add a particle of the phase v
+	 *
+	 * \param pos position of the particle
+	 * \param ele particle id
+	 * \param v phase
+	 *
+	 */
+	inline void add(const Point<dim,T> & pos, size_t ele, size_t v)
+	{
+		ph.get(v).add(pos,ele);
+	}
+
+	/*! \brief Add a particle of the phase v into a cell
+	 *
+	 * \param cell_id cell-id
+	 * \param ele particle id
+	 * \param v phase
+	 *
+	 */
+	inline void addCell(size_t cell_id, size_t ele, size_t v)
+	{
+		ph.get(v).addCell(cell_id,ele);
+	}
+
+	/*! \brief Fill the Cell-list of the phase v
+	 *
+	 * \param v phase
+	 * \param pos vector of positions of the phase v
+	 * \param g_m marker
+	 * \param opt option like CL_SYMMETRIC or CL_NON_SYMMETRIC
+	 *
+	 */
+	void fill(size_t v, const openfpm::vector<Point<dim,T>> & pos, size_t g_m, size_t opt = CL_NON_SYMMETRIC)
+	{
+		ph.get(v).fill(pos,g_m,opt);
+	}
+
+	/*! \brief Clear all the phases
+	 *
+	 */
+	void clear()
+	{
+		for (size_t v = 0 ; v < ph.size() ; v++)
+			ph.get(v).clear();
+	}
+
+	/*! \brief Get the Neighborhood iterator
+	 *
+	 * It iterate across all the particles of all the phases in the neighborhood cells
+	 *
+	 * \param cell cell id
+	 *
+	 * \return An iterator across the neighborhood particles
+	 *
+	 */
+	template<unsigned int impl=NO_CHECK> inline CellNNIteratorMPhase<dim,CellListMPhase<dim,T,CellBase>,FULL,impl> getNNIterator(size_t cell)
+	{
+		CellNNIteratorMPhase<dim,CellListMPhase<dim,T,CellBase>,FULL,impl> cln(cell,ph.get(0).getNNc_full(),*this);
+
+		return cln;
+	}
+
+	/*! \brief Get the symmetric Neighborhood iterator
+	 *
+	 * It iterate across all the particles of all the phases in the half neighborhood of the
+	 * cell, each couple of particles is visited only once
+	 *
+	 * \param cell cell id
+	 * \param pp phase of the particle p
+	 * \param p particle id
+	 * \param pos position of the particles of the phase pp
+	 * \param ps position of the particles of all the phases
+	 *
+	 * \return An iterator across the neighborhood particles
+	 *
+	 */
+	template<unsigned int impl=NO_CHECK> inline CellNNIteratorSymMPhase<dim,CellListMPhase<dim,T,CellBase>,SYM,impl>
+	getNNIteratorSym(size_t cell,
+					 size_t pp,
+					 size_t p,
+					 const openfpm::vector<Point<dim,T>> & pos,
+					 const openfpm::vector<pos_v<dim,T>> & ps)
+	{
+		CellNNIteratorSymMPhase<dim,CellListMPhase<dim,T,CellBase>,SYM,impl> cln(cell,pp,p,ph.get(0).getNNc_sym(),*this,pos,ps);
+
+		return cln;
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLLISTMPHASE_HPP_ */
@@ -0,0 +1,141 @@
+/*
+ * CellList_pair_sym.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_CELLLIST_PAIR_SYM_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_CELLLIST_PAIR_SYM_HPP_
+
+#include "NN/CellList/CellList.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*! \brief Calculate the symmetric interactions of the particles in [start,stop)
+ *
+ * \tparam n_comp number of components accumulated for each particle
+ *
+ * \param cl symmetric Cell-list
+ * \param pos particle positions
+ * \param start first particle
+ * \param stop last particle (excluded)
+ * \param r_cut2 square of the cut-off radius
+ * \param acc accumulation buffer (n_comp components for each particle)
+ * \param f functor called for each pair
+ *
+ */
+template<unsigned int n_comp, unsigned int dim, typename T, typename CellList_type, typename Functor>
+inline void for_each_pair_sym_impl(CellList_type & cl, const openfpm::vector<Point<dim,T>> & pos, size_t start, size_t stop, T r_cut2, T * acc, Functor & f)
+{
+	for (size_t p = start ; p < stop ; p++)
+	{
+		Point<dim,T> xp = pos.template get<0>(p);
+
+		auto NN = cl.template getNNIteratorSym<NO_CHECK>(cl.getCell(xp),p,pos);
+
+		while (NN.isNext())
+		{
+			size_t q = NN.get();
+
+			if (q != p)
+			{
+				Point<dim,T> xq = pos.template get<0>(q);
+				T r2 = xp.distance2(xq);
+
+				if (r2 < r_cut2)
+					f(p,q,r2,acc + n_comp*p,acc + n_comp*q);
+			}
+
+			++NN;
+		}
+	}
+}
+
+/*! \brief Calculate a symmetric pair interaction for all the particles
+ *
+ * Each pair of particles (p,q) closer than r_cut is visited only one time and the functor
+ * must accumulate the contribution on both the particles (Newton's third law)
+ *
+ * \code
+ * f(size_t p, size_t q, T r2, T * acc_p, T * acc_q)
+ * \endcode
+ *
+ * where r2 is the square distance and acc_p, acc_q point to the n_comp components of p and q.
+ * With OpenMP the domain particles are divided across the threads set on the Cell-list with
+ * setNThreads (serial by default), every thread accumulate in a private buffer and the buffers
+ * are summed at the end, so the functor does not have to care about data races.
+ *
+ * \tparam n_comp number of components accumulated for each particle (for example dim for a force)
+ *
+ * \param cl Cell-list filled in a symmetric way (CL_SYMMETRIC)
+ * \param pos particle positions (domain + ghost)
+ * \param g_m ghost marker, the interactions are calculated for the domain particles
+ * \param r_cut cut-off radius
+ * \param acc accumulation vector of size n_comp*pos.size(), the contributions are added to it
+ *        (ghost particles included)
+ * \param f functor
+ *
+ */
+template<unsigned int n_comp, unsigned int dim, typename T, typename CellList_type, typename Functor>
+void for_each_pair_sym(CellList_type & cl, const openfpm::vector<Point<dim,T>> & pos, size_t g_m, T r_cut, openfpm::vector<T> & acc, Functor f)
+{
+	T r_cut2 = r_cut * r_cut;
+
+	size_t n_acc = n_comp * pos.size();
+
+	if (n_acc == 0)
+		return;
+
+#ifdef _OPENMP
+
+	size_t n_thr = cl.getNThreads();
+	n_thr = (n_thr > g_m)?g_m:n_thr;
+
+	if (n_thr > 1)
+	{
+		// private buffers, the first thread use directly acc
+
+		openfpm::vector<openfpm::vector<T>> buf;
+		buf.resize(n_thr);
+
+		for (size_t k = 1 ; k < n_thr ; k++)
+		{
+			buf.get(k).resize(n_acc);
+
+			for (size_t i = 0 ; i < n_acc ; i++)
+				buf.get(k).get(i) = 0.0;
+		}
+
+		#pragma omp parallel num_threads(n_thr)
+		{
+			// the runtime can give less threads than requested
+			size_t n_team = omp_get_num_threads();
+			size_t t = omp_get_thread_num();
+
+			T * a = (t == 0)?&acc.get(0):&buf.get(t).get(0);
+
+			for_each_pair_sym_impl<n_comp>(cl,pos,g_m * t / n_team,g_m * (t+1) / n_team,r_cut2,a,f);
+
+			#pragma omp barrier
+
+			// reduction
+
+			#pragma omp for
+			for (size_t i = 0 ; i < n_acc ; i++)
+			{
+				for (size_t k = 1 ; k < n_team ; k++)
+					acc.get(i) += buf.get(k).get(i);
+			}
+		}
+
+		return;
+	}
+
+#endif
+
+	for_each_pair_sym_impl<n_comp>(cl,pos,0,g_m,r_cut2,&acc.get(0),f);
+}
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLLIST_PAIR_SYM_HPP_ */
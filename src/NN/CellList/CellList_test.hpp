@@ -7,6 +7,11 @@
 
 #include "CellList.hpp"
 #include "CellListM.hpp"
+#include "CellList_pair_sym.hpp"
+#include "CellNNForEach.hpp"
+#include "CellListML.hpp"
+#include "CellListMPhase.hpp"
+#include "CellPairTasks.hpp"
 #include "Grid/grid_sm.hpp"
 
 #ifndef CELLLIST_TEST_HPP_
@@ -349,6 +354,1045 @@ template<typename CellList> void Test_CellDecomposer_consistent()
 	BOOST_REQUIRE_EQUAL(bx_sub.getHigh(1),1.0f/5.0f);
 }
 
+/*! \brief Test that the two pass construction produce the same cell-list of add()
+ *
+ * \tparam CellS Cell-list type
+ *
+ */
+template<typename CellS> void Test_cell_fill()
+{
+	Box<3,double> box({-1.0,-1.0,-1.0},{1.0,1.0,1.0});
+	size_t div[3] = {8,8,8};
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 4096 ; i++)
+	{
+		Point<3,double> p;
+
+		// cluster half of the particles in a corner
+		double sc = (i % 2)?2.0:0.3;
+
+		p.get(0) = -1.0 + sc * (double)rand() / RAND_MAX;
+		p.get(1) = -1.0 + sc * (double)rand() / RAND_MAX;
+		p.get(2) = -1.0 + sc * (double)rand() / RAND_MAX;
+
+		pos.add(p);
+	}
+
+	size_t g_m = pos.size() / 2;
+
+	for (size_t opt = CL_SYMMETRIC ; opt <= CL_NON_SYMMETRIC ; opt++)
+	{
+		CellS cl1(box,div);
+		CellS cl2(box,div);
+
+		// force more threads than cores to check the multi-thread construction
+		cl2.setNThreads(4);
+
+		if (opt == CL_NON_SYMMETRIC)
+			populate_cell_list_no_sym(pos,cl1,g_m);
+		else
+			populate_cell_list_sym(pos,cl1,g_m);
+
+		// fill twice to check the reuse of the structures
+		cl2.fill(pos,g_m,opt);
+		cl2.fill(pos,g_m,opt);
+
+		size_t tot = 0;
+
+		for (size_t c = 0 ; c < cl1.getGrid().size() ; c++)
+		{
+			BOOST_REQUIRE_EQUAL(cl1.getNelements(c),cl2.getNelements(c));
+
+			for (size_t j = 0 ; j < cl1.getNelements(c) ; j++)
+				BOOST_REQUIRE_EQUAL(cl1.get(c,j),cl2.get(c,j));
+
+			tot += cl2.getNelements(c);
+		}
+
+		BOOST_REQUIRE_EQUAL(tot,pos.size());
+	}
+
+	// the number of threads follow the swapped data
+
+	CellS cl3(box,div);
+	CellS cl4(box,div);
+	cl3.setNThreads(4);
+
+	cl3.swap(cl4);
+
+	BOOST_REQUIRE_EQUAL(cl3.getNThreads(),1ul);
+	BOOST_REQUIRE_EQUAL(cl4.getNThreads(),4ul);
+}
+
+/*! \brief Test that the incremental update produce the same cells of fill
+ *
+ * \tparam CellS Cell-list type
+ *
+ */
+template<typename CellS> void Test_cell_update()
+{
+	Box<3,double> box({-1.0,-1.0,-1.0},{1.0,1.0,1.0});
+	size_t div[3] = {8,8,8};
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 4096 ; i++)
+	{
+		Point<3,double> p;
+
+		p.get(0) = -1.0 + 2.0 * (double)rand() / RAND_MAX;
+		p.get(1) = -1.0 + 2.0 * (double)rand() / RAND_MAX;
+		p.get(2) = -1.0 + 2.0 * (double)rand() / RAND_MAX;
+
+		pos.add(p);
+	}
+
+	size_t g_m = pos.size() / 2;
+
+	for (size_t opt = CL_SYMMETRIC ; opt <= CL_NON_SYMMETRIC ; opt++)
+	{
+		CellS cl1(box,div);
+		CellS cl2(box,div);
+
+		cl1.fill(pos,g_m,opt);
+
+		for (size_t step = 0 ; step < 10 ; step++)
+		{
+			// move some particles
+
+			openfpm::vector<size_t> changed;
+
+			for (size_t i = step ; i < pos.size() ; i += 7)
+			{
+				for (size_t j = 0 ; j < 3 ; j++)
+				{
+					double x = pos.template get<0>(i)[j] + 0.1 * ((double)rand() / RAND_MAX - 0.5);
+					pos.template get<0>(i)[j] = (x < -1.0)?-1.0:((x >= 1.0)?0.999:x);
+				}
+
+				changed.add(i);
+			}
+
+			if (step % 2 == 0)
+				cl1.update(pos,g_m,opt);
+			else
+				cl1.update(pos,changed,g_m,opt);
+
+			cl2.fill(pos,g_m,opt);
+
+			for (size_t c = 0 ; c < cl1.getGrid().size() ; c++)
+			{
+				BOOST_REQUIRE_EQUAL(cl1.getNelements(c),cl2.getNelements(c));
+
+				openfpm::vector<size_t> e1;
+				openfpm::vector<size_t> e2;
+
+				for (size_t j = 0 ; j < cl1.getNelements(c) ; j++)
+				{
+					e1.add(cl1.get(c,j));
+					e2.add(cl2.get(c,j));
+				}
+
+				e1.sort();
+				e2.sort();
+
+				for (size_t j = 0 ; j < e1.size() ; j++)
+					BOOST_REQUIRE_EQUAL(e1.get(j),e2.get(j));
+			}
+		}
+	}
+}
+
+/*! \brief Test the symmetric pair driver against a brute-force calculation
+ *
+ * \param n_thr number of threads
+ *
+ */
+void Test_pair_sym(int n_thr)
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	double r_cut = 0.1;
+	Ghost<3,double> g(r_cut);
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 2048 ; i++)
+	{
+		Point<3,double> p;
+
+		p.get(0) = (double)rand() / RAND_MAX;
+		p.get(1) = (double)rand() / RAND_MAX;
+		p.get(2) = (double)rand() / RAND_MAX;
+
+		pos.add(p);
+	}
+
+	size_t g_m = pos.size();
+
+	// symmetric Cell-list
+	size_t pad = 0;
+	CellDecomposer_sm<3,double,shift<3,double>> cd_sm;
+	cl_param_calculateSym<3,double>(box,cd_sm,g,r_cut,pad);
+
+	CellList<3,double,Mem_fast<>,shift<3,double>> cl;
+	cl.Initialize(cd_sm,box,pad);
+	populate_cell_list(pos,cl,g_m,CL_SYMMETRIC);
+
+	cl.setNThreads(n_thr);
+
+	// component 0 count the neighborhood, component 1 sum the square distances
+	openfpm::vector<double> acc;
+	acc.resize(2*pos.size());
+	acc.fill(0);
+
+	for_each_pair_sym<2>(cl,pos,g_m,r_cut,acc,[](size_t p, size_t q, double r2, double * acc_p, double * acc_q)
+	{
+		acc_p[0] += 1.0;
+		acc_q[0] += 1.0;
+
+		acc_p[1] += r2;
+		acc_q[1] += r2;
+	});
+
+	for (size_t p = 0 ; p < pos.size() ; p++)
+	{
+		Point<3,double> xp = pos.template get<0>(p);
+
+		double n_nn = 0.0;
+		double r2_sum = 0.0;
+
+		for (size_t q = 0 ; q < pos.size() ; q++)
+		{
+			Point<3,double> xq = pos.template get<0>(q);
+			double r2 = xp.distance2(xq);
+
+			if (q != p && r2 < r_cut*r_cut)
+			{
+				n_nn += 1.0;
+				r2_sum += r2;
+			}
+		}
+
+		BOOST_REQUIRE_EQUAL(acc.get(2*p),n_nn);
+		BOOST_REQUIRE_CLOSE(acc.get(2*p+1),r2_sum,0.0001);
+	}
+}
+
+/*! \brief Check that for_each_neighbor visit the same particles of the neighborhood iterators
+ *
+ * \tparam dim dimensionality
+ * \tparam CellS Cell-list type
+ *
+ */
+template<unsigned int dim, typename CellS> void Test_for_each_neighbor()
+{
+	Box<dim,double> box;
+	size_t div[dim];
+
+	for (size_t i = 0 ; i < dim ; i++)
+	{
+		box.setLow(i,0.0);
+		box.setHigh(i,1.0);
+		div[i] = 8;
+	}
+
+	CellS cl;
+	cl.Initialize(box,div,1);
+
+	openfpm::vector<Point<dim,double>> pos;
+
+	for (size_t i = 0 ; i < 2000 ; i++)
+	{
+		Point<dim,double> p;
+
+		for (size_t j = 0 ; j < dim ; j++)
+			p.get(j) = (double)rand() / RAND_MAX;
+
+		pos.add(p);
+		cl.add(p,i);
+	}
+
+	typedef typename CellS::Mem_type_type::loc_index loc_index;
+
+	for (size_t i = 0 ; i < pos.size() ; i++)
+	{
+		Point<dim,double> xp = pos.template get<0>(i);
+		size_t cell = cl.getCell(xp);
+
+		//! [Usage of for_each_neighbor]
+
+		openfpm::vector<size_t> nn_full;
+
+		for_each_neighbor<dim,FULL>(cl,cell,[&](const loc_index * start, const loc_index * stop)
+		{
+			for (const loc_index * q = start ; q != stop ; q++)
+				nn_full.add(*q);
+		});
+
+		//! [Usage of for_each_neighbor]
+
+		openfpm::vector<size_t> nn_full_it;
+
+		auto NN = cl.template getNNIterator<NO_CHECK>(cell);
+		while (NN.isNext())
+		{
+			nn_full_it.add(NN.get());
+			++NN;
+		}
+
+		BOOST_REQUIRE_EQUAL(nn_full.size(),nn_full_it.size());
+		for (size_t k = 0 ; k < nn_full.size() ; k++)
+			BOOST_REQUIRE_EQUAL(nn_full.get(k),nn_full_it.get(k));
+
+		openfpm::vector<size_t> nn_sym;
+
+		for_each_neighbor<dim,SYM>(cl,cell,[&](const loc_index * start, const loc_index * stop)
+		{
+			for (const loc_index * q = start ; q != stop ; q++)
+				nn_sym.add(*q);
+		});
+
+		openfpm::vector<size_t> nn_sym_it;
+
+		CellNNIterator<dim,CellS,SYM,NO_CHECK> NNs(cell,cl.getNNc_sym(),cl);
+		while (NNs.isNext())
+		{
+			nn_sym_it.add(NNs.get());
+			++NNs;
+		}
+
+		BOOST_REQUIRE_EQUAL(nn_sym.size(),nn_sym_it.size());
+		for (size_t k = 0 ; k < nn_sym.size() ; k++)
+			BOOST_REQUIRE_EQUAL(nn_sym.get(k),nn_sym_it.get(k));
+
+		// CRS use the symmetric neighborhood
+
+		size_t n_crs = 0;
+
+		for_each_neighbor<dim,CRS>(cl,cell,[&](const loc_index * start, const loc_index * stop)
+		{
+			n_crs += stop - start;
+		});
+
+		BOOST_REQUIRE_EQUAL(n_crs,nn_sym_it.size());
+	}
+}
+
+/*! \brief Check the multi-level Cell-list against a brute force search
+ *
+ * The particles have radius with a factor 20 of difference, two particles interact if the
+ * distance is smaller than the biggest of the two radius
+ *
+ */
+template<typename Mem_type> void Test_cell_ML()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {64,64,64};
+
+	CellListML<3,double,Mem_type> cl;
+	cl.Initialize(box,div,5);
+
+	openfpm::vector<Point<3,double>> pos;
+	openfpm::vector<double> r;
+
+	for (size_t i = 0 ; i < 1500 ; i++)
+	{
+		Point<3,double> p({(double)rand() / RAND_MAX,(double)rand() / RAND_MAX,(double)rand() / RAND_MAX});
+
+		pos.add(p);
+
+		if (i % 10 == 0)
+			r.add(0.1 + 0.1 * (double)rand() / RAND_MAX);
+		else
+			r.add(0.01 + 0.01 * (double)rand() / RAND_MAX);
+	}
+
+	cl.fill(pos,r);
+
+	BOOST_REQUIRE_EQUAL(cl.selectLevel(0.01),0ul);
+	BOOST_REQUIRE_EQUAL(cl.selectLevel(0.2),4ul);
+
+	size_t tot = 0;
+	for (size_t l = 0 ; l < cl.getNLevels() ; l++)
+		tot += cl.getNParticles(l);
+
+	BOOST_REQUIRE_EQUAL(tot,pos.size());
+
+	for (size_t p = 0 ; p < pos.size() ; p++)
+	{
+		Point<3,double> xp = pos.template get<0>(p);
+
+		size_t n_nn = 0;
+
+		cl.forEachNN(xp,r.get(p),[&](size_t q)
+		{
+			Point<3,double> xq = pos.template get<0>(q);
+			double rc = std::max(r.get(p),r.get(q));
+
+			if (q != p && xp.distance2(xq) < rc*rc)
+				n_nn++;
+		});
+
+		size_t n_nn_bf = 0;
+
+		for (size_t q = 0 ; q < pos.size() ; q++)
+		{
+			Point<3,double> xq = pos.template get<0>(q);
+			double rc = std::max(r.get(p),r.get(q));
+
+			if (q != p && xp.distance2(xq) < rc*rc)
+				n_nn_bf++;
+		}
+
+		BOOST_REQUIRE_EQUAL(n_nn,n_nn_bf);
+	}
+}
+
+/*! \brief Sparse Cell-list on a big domain with a small cluster of particles
+ *
+ */
+void Test_cell_sparse()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+
+	// ~ 8 * 10^9 cells
+	size_t div[3] = {2048,2048,2048};
+	double r_cut = 1.0 / 2048;
+
+	CellList<3,double,Mem_sparse<>> cl;
+	cl.Initialize(box,div);
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 2000 ; i++)
+	{
+		Point<3,double> p({0.5 + 0.01 * (double)rand() / RAND_MAX,
+		                   0.5 + 0.01 * (double)rand() / RAND_MAX,
+		                   0.5 + 0.01 * (double)rand() / RAND_MAX});
+
+		pos.add(p);
+	}
+
+	cl.fill(pos,pos.size());
+
+	BOOST_REQUIRE(cl.size() <= pos.size());
+
+	for (size_t p = 0 ; p < pos.size() ; p++)
+	{
+		Point<3,double> xp = pos.template get<0>(p);
+
+		size_t n_nn = 0;
+
+		auto NN = cl.getNNIterator(cl.getCell(xp));
+		while (NN.isNext())
+		{
+			size_t q = NN.get();
+
+			Point<3,double> xq = pos.template get<0>(q);
+			if (q != p && xp.distance2(xq) < r_cut*r_cut)
+				n_nn++;
+
+			++NN;
+		}
+
+		size_t n_nn_bf = 0;
+
+		for (size_t q = 0 ; q < pos.size() ; q++)
+		{
+			Point<3,double> xq = pos.template get<0>(q);
+			if (q != p && xp.distance2(xq) < r_cut*r_cut)
+				n_nn_bf++;
+		}
+
+		BOOST_REQUIRE_EQUAL(n_nn,n_nn_bf);
+	}
+}
+
+/*! \brief Brute force k nearest neighborhood
+ *
+ * \param pos particle positions
+ * \param xp point
+ * \param k number of neighborhood
+ * \param skip particle to exclude
+ * \param nn sorted (square distance,id) of the k nearest
+ *
+ */
+void knn_brute_force(openfpm::vector<Point<3,double>> & pos, const Point<3,double> & xp, size_t k, size_t skip, openfpm::vector<std::pair<double,size_t>> & nn)
+{
+	nn.clear();
+
+	for (size_t q = 0 ; q < pos.size() ; q++)
+	{
+		if (q == skip)	continue;
+
+		Point<3,double> xq = pos.template get<0>(q);
+		nn.add(std::pair<double,size_t>(xq.distance2(xp),q));
+	}
+
+	std::sort(&nn.get(0),&nn.get(0) + nn.size());
+	nn.resize((k < nn.size())?k:nn.size());
+}
+
+/*! \brief Check the k nearest neighborhood search of the Cell-list
+ *
+ * \tparam CellS Cell-list type
+ *
+ */
+template<typename CellS> void Test_cell_knn()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {16,16,16};
+
+	CellS cl;
+	cl.Initialize(box,div);
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 1000 ; i++)
+	{
+		// some particles outside the box (in the padding cells)
+		Point<3,double> p({1.05 * (double)rand() / RAND_MAX - 0.025,(double)rand() / RAND_MAX,(double)rand() / RAND_MAX});
+		pos.add(p);
+	}
+
+	cl.fill(pos,pos.size());
+
+	openfpm::vector<size_t> ids;
+	openfpm::vector<double> dist2;
+	openfpm::vector<std::pair<double,size_t>> nn;
+
+	for (size_t i = 0 ; i < 100 ; i++)
+	{
+		Point<3,double> xp({(double)rand() / RAND_MAX,(double)rand() / RAND_MAX,(double)rand() / RAND_MAX});
+
+		cl.getKNN(pos,xp,10,ids,dist2);
+		knn_brute_force(pos,xp,10,pos.size(),nn);
+
+		BOOST_REQUIRE_EQUAL(ids.size(),10ul);
+
+		for (size_t j = 0 ; j < 10 ; j++)
+		{
+			BOOST_REQUIRE_EQUAL(ids.get(j),nn.get(j).second);
+			BOOST_REQUIRE_EQUAL(dist2.get(j),nn.get(j).first);
+		}
+	}
+
+	// more neighborhood than particles
+
+	cl.getKNN(pos,pos.template get<0>(0),2000,ids,dist2);
+	BOOST_REQUIRE_EQUAL(ids.size(),pos.size());
+
+	// all the particles
+
+	cl.getKNN_all(pos,5,ids,dist2);
+
+	for (size_t p = 0 ; p < pos.size() ; p++)
+	{
+		knn_brute_force(pos,pos.template get<0>(p),5,p,nn);
+
+		for (size_t j = 0 ; j < 5 ; j++)
+		{
+			BOOST_REQUIRE_EQUAL(ids.get(5*p+j),nn.get(j).second);
+			BOOST_REQUIRE_EQUAL(dist2.get(5*p+j),nn.get(j).first);
+		}
+	}
+
+	// more neighborhood than particles, the slots not filled are marked
+
+	openfpm::vector<Point<3,double>> pos_s;
+
+	for (size_t i = 0 ; i < 4 ; i++)
+		pos_s.add(pos.get(i));
+
+	cl.fill(pos_s,pos_s.size());
+
+	// ids and dist2 still contain the result of the previous query
+	cl.getKNN_all(pos_s,5,ids,dist2);
+
+	BOOST_REQUIRE_EQUAL(ids.size(),5*pos_s.size());
+
+	for (size_t p = 0 ; p < pos_s.size() ; p++)
+	{
+		for (size_t j = 0 ; j < 3 ; j++)
+			BOOST_REQUIRE(ids.get(5*p+j) < pos_s.size());
+
+		for (size_t j = 3 ; j < 5 ; j++)
+		{
+			BOOST_REQUIRE_EQUAL(ids.get(5*p+j),KNN_NO_PARTICLE);
+			BOOST_REQUIRE_EQUAL(dist2.get(5*p+j),std::numeric_limits<double>::max());
+		}
+	}
+}
+
+/*! \brief Test the multi-phase Cell-list without bit-packing against a brute force search
+ *
+ * \tparam CellS multi-phase Cell-list
+ *
+ */
+template<typename CellS> void Test_cell_mphase()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {10,10,10};
+	double r_cut = 0.1;
+
+	//! [Usage of CellListMPhase]
+
+	openfpm::vector<Point<3,double>> phase0;
+	openfpm::vector<Point<3,double>> phase1;
+	openfpm::vector<Point<3,double>> phase2;
+
+	openfpm::vector<pos_v<3,double>> phases;
+	phases.add(pos_v<3,double>(phase0));
+	phases.add(pos_v<3,double>(phase1));
+	phases.add(pos_v<3,double>(phase2));
+
+	for (size_t v = 0 ; v < phases.size() ; v++)
+	{
+		for (size_t i = 0 ; i < 300 + 100*v ; i++)
+		{
+			Point<3,double> p({(double)rand() / RAND_MAX,(double)rand() / RAND_MAX,(double)rand() / RAND_MAX});
+			phases.get(v).pos.add(p);
+		}
+	}
+
+	CellS cl;
+	cl.Initialize(box,div,phases.size());
+
+	for (size_t v = 0 ; v < phases.size() ; v++)
+		cl.fill(v,phases.get(v).pos,phases.get(v).pos.size());
+
+	//! [Usage of CellListMPhase]
+
+	size_t n_pair_full = 0;
+	size_t n_pair_sym = 0;
+	size_t n_pair_bf = 0;
+
+	for (size_t pp = 0 ; pp < phases.size() ; pp++)
+	{
+		openfpm::vector<Point<3,double>> & pos = phases.get(pp).pos;
+
+		for (size_t p = 0 ; p < pos.size() ; p++)
+		{
+			Point<3,double> xp = pos.template get<0>(p);
+
+			// brute force
+
+			size_t n_bf = 0;
+			size_t sum_bf = 0;
+
+			for (size_t vq = 0 ; vq < phases.size() ; vq++)
+			{
+				for (size_t q = 0 ; q < phases.get(vq).pos.size() ; q++)
+				{
+					if (vq == pp && q == p)	continue;
+
+					Point<3,double> xq = phases.get(vq).pos.template get<0>(q);
+
+					if (xp.distance2(xq) < r_cut*r_cut)
+					{
+						n_bf++;
+						sum_bf += vq*10000 + q;
+					}
+				}
+			}
+
+			// full neighborhood
+
+			size_t n_full = 0;
+			size_t sum_full = 0;
+
+			auto NN = cl.template getNNIterator<NO_CHECK>(cl.getCell(xp));
+
+			while (NN.isNext())
+			{
+				size_t q = NN.getP();
+				size_t vq = NN.getV();
+
+				Point<3,double> xq = phases.get(vq).pos.template get<0>(q);
+
+				if ((vq != pp || q != p) && xp.distance2(xq) < r_cut*r_cut)
+				{
+					n_full++;
+					sum_full += vq*10000 + q;
+				}
+
+				++NN;
+			}
+
+			BOOST_REQUIRE_EQUAL(n_full,n_bf);
+			BOOST_REQUIRE_EQUAL(sum_full,sum_bf);
+
+			// symmetric neighborhood
+
+			auto NNs = cl.template getNNIteratorSym<NO_CHECK>(cl.getCell(xp),pp,p,pos,phases);
+
+			while (NNs.isNext())
+			{
+				size_t q = NNs.getP();
+				size_t vq = NNs.getV();
+
+				Point<3,double> xq = phases.get(vq).pos.template get<0>(q);
+
+				if ((vq != pp || q != p) && xp.distance2(xq) < r_cut*r_cut)
+					n_pair_sym++;
+
+				++NNs;
+			}
+
+			n_pair_full += n_full;
+			n_pair_bf += n_bf;
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(n_pair_full,n_pair_bf);
+	BOOST_REQUIRE_EQUAL(2*n_pair_sym,n_pair_bf);
+}
+
+/*! \brief Test the cell-pair task list on an inhomogeneous distribution of particles
+ *
+ */
+void Test_cell_pair_tasks()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {10,10,10};
+	double r_cut = 0.1;
+
+	openfpm::vector<Point<3,double>> pos;
+
+	// a dense droplet and a dilute background
+	for (size_t i = 0 ; i < 2000 ; i++)
+	{
+		double s = (i < 1500)?0.2:1.0;
+		double o = (i < 1500)?0.3:0.0;
+
+		Point<3,double> p({o + s * (double)rand() / RAND_MAX,o + s * (double)rand() / RAND_MAX,o + s * (double)rand() / RAND_MAX});
+		pos.add(p);
+	}
+
+	CellList<3,double,Mem_fast<>> cl;
+	cl.Initialize(box,div);
+	cl.fill(pos,pos.size());
+
+	//! [Usage of cell_pair_tasks]
+
+	openfpm::vector<cell_pair_task> tasks;
+	cell_pair_tasks<3>(cl,tasks);
+
+	openfpm::vector<size_t> n_pair_t;
+	n_pair_t.resize(tasks.size());
+
+	for_each_cell_pair_task(tasks,[&](const cell_pair_task & t)
+	{
+		size_t n = 0;
+
+		for (size_t i = 0 ; i < cl.getNelements(t.cell_a) ; i++)
+		{
+			size_t p = cl.get(t.cell_a,i);
+			Point<3,double> xp = pos.template get<0>(p);
+
+			// with itself only the couples with j > i
+			size_t j = (t.cell_a == t.cell_b)?i+1:0;
+
+			for ( ; j < cl.getNelements(t.cell_b) ; j++)
+			{
+				size_t q = cl.get(t.cell_b,j);
+				Point<3,double> xq = pos.template get<0>(q);
+
+				if (xp.distance2(xq) < r_cut*r_cut)
+					n++;
+			}
+		}
+
+		n_pair_t.get(&t - &tasks.get(0)) = n;
+	});
+
+	//! [Usage of cell_pair_tasks]
+
+	size_t n_pair = 0;
+	for (size_t t = 0 ; t < tasks.size() ; t++)
+		n_pair += n_pair_t.get(t);
+
+	size_t n_pair_bf = 0;
+	for (size_t p = 0 ; p < pos.size() ; p++)
+	{
+		Point<3,double> xp = pos.template get<0>(p);
+
+		for (size_t q = p+1 ; q < pos.size() ; q++)
+		{
+			Point<3,double> xq = pos.template get<0>(q);
+
+			if (xp.distance2(xq) < r_cut*r_cut)
+				n_pair_bf++;
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(n_pair,n_pair_bf);
+
+	// sorted by decreasing cost and with the correct cost
+
+	size_t tot = 0;
+	for (size_t t = 0 ; t < tasks.size() ; t++)
+	{
+		size_t n_a = cl.getNelements(tasks.get(t).cell_a);
+		size_t n_b = cl.getNelements(tasks.get(t).cell_b);
+
+		if (tasks.get(t).cell_a == tasks.get(t).cell_b)
+			BOOST_REQUIRE_EQUAL(tasks.get(t).cost,n_a*(n_a-1)/2);
+		else
+			BOOST_REQUIRE_EQUAL(tasks.get(t).cost,n_a*n_b);
+
+		if (t != 0)
+			BOOST_REQUIRE(tasks.get(t-1).cost >= tasks.get(t).cost);
+
+		tot += tasks.get(t).cost;
+	}
+
+	// the same with an explicit list of cells
+
+	openfpm::vector<size_t> dom;
+	openfpm::vector<subsub_lin<3>> anom;
+	openfpm::vector<cell_pair_task> tasks2;
+
+	grid_key_dx_iterator_sub<3> it(cl.getGrid(),grid_key_dx<3>({1,1,1}),grid_key_dx<3>({10,10,10}));
+	while (it.isNext())
+	{
+		dom.add(cl.getGrid().LinId(it.get()));
+		++it;
+	}
+
+	cell_pair_tasks<3>(cl,dom,anom,tasks2);
+	BOOST_REQUIRE_EQUAL(tasks2.size(),tasks.size());
+
+	// balanced bins
+
+	openfpm::vector<openfpm::vector<size_t>> bins;
+	openfpm::vector<size_t> load;
+
+	cell_pair_tasks_bin(tasks,4,bins,load);
+
+	size_t n_task = 0;
+	for (size_t b = 0 ; b < bins.size() ; b++)
+	{
+		BOOST_REQUIRE(load.get(b) <= tot / 4 + tasks.get(0).cost);
+		n_task += bins.get(b).size();
+	}
+
+	BOOST_REQUIRE_EQUAL(n_task,tasks.size());
+}
+
+/*! \brief Test the periodic neighborhood iterator against a brute force minimum image search
+ *
+ * \tparam CellS Cell-list
+ *
+ */
+template<typename CellS> void Test_cell_periodic()
+{
+	Box<3,double> box({0.0,0.0,0.0},{2.0,1.0,0.5});
+	size_t div[3] = {20,10,5};
+	double r_cut = 0.1;
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 2000 ; i++)
+	{
+		Point<3,double> p({2.0 * (double)rand() / RAND_MAX,(double)rand() / RAND_MAX,0.5 * (double)rand() / RAND_MAX});
+
+		// inside the box
+		p.get(0) = (p.get(0) >= 2.0)?0.0:p.get(0);
+		p.get(1) = (p.get(1) >= 1.0)?0.0:p.get(1);
+		p.get(2) = (p.get(2) >= 0.5)?0.0:p.get(2);
+
+		pos.add(p);
+	}
+
+	//! [Usage of periodic NN iterator]
+
+	CellS cl;
+	cl.Initialize(box,div);
+	cl.fill(pos,pos.size());
+
+	for (size_t p = 0 ; p < pos.size() ; p++)
+	{
+		Point<3,double> xp = pos.template get<0>(p);
+
+		size_t n = 0;
+		double sum = 0.0;
+
+		auto NN = cl.template getNNIteratorPeriodic<NO_CHECK>(cl.getCell(xp));
+
+		while (NN.isNext())
+		{
+			size_t q = NN.get();
+			Point<3,double> xq = pos.template get<0>(q);
+			xq += NN.getShift();
+
+			double r2 = xp.distance2(xq);
+
+			if (q != p && r2 < r_cut*r_cut)
+			{
+				n++;
+				sum += r2;
+			}
+
+			++NN;
+		}
+
+		//! [Usage of periodic NN iterator]
+
+		// brute force with the minimum image
+
+		size_t n_bf = 0;
+		double sum_bf = 0.0;
+
+		for (size_t q = 0 ; q < pos.size() ; q++)
+		{
+			if (q == p)	continue;
+
+			double r2 = 0.0;
+
+			for (size_t i = 0 ; i < 3 ; i++)
+			{
+				double L = box.getHigh(i) - box.getLow(i);
+				double d = pos.template get<0>(q)[i] - xp.get(i);
+				d -= L * std::round(d / L);
+				r2 += d*d;
+			}
+
+			if (r2 < r_cut*r_cut)
+			{
+				n_bf++;
+				sum_bf += r2;
+			}
+		}
+
+		BOOST_REQUIRE_EQUAL(n,n_bf);
+		BOOST_REQUIRE_CLOSE(sum,sum_bf,0.0001);
+	}
+}
+
+/*! \brief Test the tiled iteration across the domain cells
+ *
+ */
+void Test_cell_tile_iterator()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {16,12,7};
+	double r_cut = 1.0 / 16.0;
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 5000 ; i++)
+	{
+		Point<3,double> p({(double)rand() / (RAND_MAX + 1.0),(double)rand() / (RAND_MAX + 1.0),(double)rand() / (RAND_MAX + 1.0)});
+		pos.add(p);
+	}
+
+	CellList<3,double,Mem_fast<>> cl;
+	cl.Initialize(box,div);
+	cl.fill(pos,pos.size());
+
+	const grid_sm<3,void> & gs = cl.getGrid();
+
+	// every domain cell visited exactly once
+
+	size_t tile[3] = {5,5,5};
+	openfpm::vector<size_t> visit;
+	visit.resize(gs.size());
+
+	for (size_t t = 0 ; t < 2 ; t++)
+	{
+		for (size_t c = 0 ; c < visit.size() ; c++)
+			visit.get(c) = 0;
+
+		auto it = (t == 0)?cl.getTileIterator(tile):cl.getTileIterator();
+
+		while (it.isNext())
+		{
+			visit.get(it.getCell())++;
+			++it;
+		}
+
+		grid_key_dx_iterator<3> g_it(gs);
+
+		while (g_it.isNext())
+		{
+			auto key = g_it.get();
+			bool dom = true;
+
+			for (size_t i = 0 ; i < 3 ; i++)
+				dom &= key.get(i) >= 1 && key.get(i) <= (long int)div[i];
+
+			BOOST_REQUIRE_EQUAL(visit.get(gs.LinId(key)),(dom == true)?1ul:0ul);
+
+			++g_it;
+		}
+	}
+
+	// tile size from the cache
+
+	size_t tile_c[3];
+	CellTileIterator<3>::calculateTile(gs,cl.getPadding(),1000.0,32,262144,tile_c);
+
+	BOOST_REQUIRE_EQUAL(tile_c[0],1ul);
+
+	CellTileIterator<3>::calculateTile(gs,cl.getPadding(),1.0,32,262144,tile_c);
+
+	BOOST_REQUIRE_EQUAL(tile_c[0],16ul);
+	BOOST_REQUIRE_EQUAL(tile_c[2],7ul);
+
+	//! [Usage of tile iterator]
+
+	size_t n_pair = 0;
+
+	auto it = cl.getTileIterator(tile);
+
+	while (it.isNext())
+	{
+		size_t c = it.getCell();
+
+		for (size_t i = 0 ; i < cl.getNelements(c) ; i++)
+		{
+			size_t p = cl.get(c,i);
+			Point<3,double> xp = pos.template get<0>(p);
+
+			auto NN = cl.template getNNIterator<NO_CHECK>(c);
+
+			while (NN.isNext())
+			{
+				size_t q = NN.get();
+				Point<3,double> xq = pos.template get<0>(q);
+
+				if (q != p && xp.distance2(xq) < r_cut*r_cut)
+					n_pair++;
+
+				++NN;
+			}
+		}
+
+		++it;
+	}
+
+	//! [Usage of tile iterator]
+
+	size_t n_pair_bf = 0;
+	for (size_t p = 0 ; p < pos.size() ; p++)
+	{
+		Point<3,double> xp = pos.template get<0>(p);
+
+		for (size_t q = 0 ; q < pos.size() ; q++)
+		{
+			Point<3,double> xq = pos.template get<0>(q);
+
+			if (q != p && xp.distance2(xq) < r_cut*r_cut)
+				n_pair_bf++;
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(n_pair,n_pair_bf);
+}
+
 BOOST_AUTO_TEST_SUITE( CellList_test )
 
 BOOST_AUTO_TEST_CASE( CellList_use)
@@ -362,15 +1406,101 @@ BOOST_AUTO_TEST_CASE( CellList_use)
 	Test_cell_sM<3,double,CellListM<3,double,8>>(box);
 	Test_cell_sM<3,double,CellListM<3,double,8>>(box2);
 
+	// 32-bit local index
+	Test_cell_s<3,double,CellList<3,double,Mem_fast<unsigned int>,shift<3,double>>>(box2);
+	Test_cell_s<3,double,CellList<3,double,Mem_compact<unsigned int>>>(box);
+	Test_cell_sM<3,double,CellListM<3,double,8,CellList<3,double,Mem_fast<unsigned int>,shift<3,double>>>>(box);
+
 
 	Test_cell_s<3,double,CellList<3,double,Mem_bal<>>>(box);
 	Test_cell_s<3,double,CellList<3,double,Mem_mw<>>>(box);
+	Test_cell_s<3,double,CellList<3,double,Mem_compact<>>>(box);
+	Test_cell_s<3,double,CellList<3,double,Mem_sparse<>>>(box);
 
 	std::cout << "End cell list" << "\n";
 
 	// Test the cell list
 }
 
+BOOST_AUTO_TEST_CASE( CellList_update )
+{
+	Test_cell_update<CellList<3,double,Mem_fast<>,shift<3,double>>>();
+	Test_cell_update<CellList<3,double,Mem_bal<>,shift<3,double>>>();
+	Test_cell_update<CellList<3,double,Mem_mw<>,shift<3,double>>>();
+	Test_cell_update<CellList<3,double,Mem_compact<>,shift<3,double>>>();
+	Test_cell_update<CellList<3,double,Mem_sparse<>,shift<3,double>>>();
+	Test_cell_update<CellList<3,double,Mem_fast<unsigned int>,shift<3,double>>>();
+}
+
+BOOST_AUTO_TEST_CASE( CellList_pair_sym )
+{
+	Test_pair_sym(1);
+	Test_pair_sym(4);
+}
+
+BOOST_AUTO_TEST_CASE( CellList_for_each_neighbor )
+{
+	Test_for_each_neighbor<2,CellList<2,double,Mem_fast<>>>();
+	Test_for_each_neighbor<3,CellList<3,double,Mem_fast<>>>();
+	Test_for_each_neighbor<3,CellList<3,double,Mem_bal<>>>();
+	Test_for_each_neighbor<3,CellList<3,double,Mem_compact<>>>();
+	Test_for_each_neighbor<3,CellList<3,double,Mem_sparse<>>>();
+	Test_for_each_neighbor<3,CellList<3,double,Mem_fast<unsigned int>>>();
+}
+
+BOOST_AUTO_TEST_CASE( CellList_multi_level )
+{
+	Test_cell_ML<Mem_fast<>>();
+	Test_cell_ML<Mem_compact<>>();
+}
+
+BOOST_AUTO_TEST_CASE( CellList_sparse )
+{
+	Test_cell_sparse();
+}
+
+BOOST_AUTO_TEST_CASE( CellList_knn )
+{
+	Test_cell_knn<CellList<3,double,Mem_fast<>>>();
+	Test_cell_knn<CellList<3,double,Mem_compact<>>>();
+	Test_cell_knn<CellList<3,double,Mem_sparse<>>>();
+	Test_cell_knn<CellList<3,double,Mem_fast<unsigned int>>>();
+}
+
+BOOST_AUTO_TEST_CASE( CellList_multi_phase )
+{
+	Test_cell_mphase<CellListMPhase<3,double>>();
+	Test_cell_mphase<CellListMPhase<3,double,CellList<3,double,Mem_fast<unsigned int>,shift<3,double>>>>();
+}
+
+BOOST_AUTO_TEST_CASE( CellList_pair_tasks )
+{
+	Test_cell_pair_tasks();
+}
+
+BOOST_AUTO_TEST_CASE( CellList_periodic )
+{
+	Test_cell_periodic<CellList<3,double,Mem_fast<>>>();
+	Test_cell_periodic<CellList<3,double,Mem_fast<>,shift<3,double>>>();
+	Test_cell_periodic<CellList<3,double,Mem_compact<>>>();
+	Test_cell_periodic<CellList<3,double,Mem_fast<unsigned int>>>();
+}
+
+BOOST_AUTO_TEST_CASE( CellList_tile_iterator )
+{
+	Test_cell_tile_iterator();
+}
+
+BOOST_AUTO_TEST_CASE( CellList_fill )
+{
+	Test_cell_fill<CellList<3,double,Mem_fast<>>>();
+	Test_cell_fill<CellList<3,double,Mem_bal<>>>();
+	Test_cell_fill<CellList<3,double,Mem_mw<>>>();
+	Test_cell_fill<CellList<3,double,Mem_compact<>>>();
+	Test_cell_fill<CellList<3,double,Mem_sparse<>>>();
+	Test_cell_fill<CellList<3,double,Mem_fast<unsigned int>>>();
+}
+
 BOOST_AUTO_TEST_CASE( CellList_consistent )
 {
 	Test_CellDecomposer_consistent<CellList<2,float,Mem_fast<>,shift<2,float>>>();
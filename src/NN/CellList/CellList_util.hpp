@@ -13,6 +13,32 @@
 
 #include "Vector/map_vector.hpp"
 
+template<typename T, typename Sfinae = void>
+struct has_set_n_elements: std::false_type {};
+
+/*! \brief has_set_n_elements check if a memory structure of the cell-list can be
+ *         filled writing directly the elements (in parallel) after init_to_count
+ *
+ * return true if T::set_n_elements is a valid expression
+ *
+ */
+template<typename T>
+struct has_set_n_elements<T, typename Void<decltype( &T::set_n_elements )>::type> : std::true_type
+{};
+
+template<typename T, typename Sfinae = void>
+struct has_add_count: std::false_type {};
+
+/*! \brief has_add_count check if a memory structure of the cell-list is sparse and must be
+ *         counted cell by cell (addCount) instead of with a counter for each cell of the grid
+ *
+ * return true if T::addCount is a valid expression
+ *
+ */
+template<typename T>
+struct has_add_count<T, typename Void<decltype( &T::addCount )>::type> : std::true_type
+{};
+
 /*! \brief populate the Cell-list with particles non symmetric case
  *
  * \tparam dim dimensionality of the space
@@ -61,6 +87,9 @@ template<unsigned int dim, typename T, typename CellList> void populate_cell_lis
 }
 
 /*! \brief populate the Cell-list with particles generic case
+ *
+ * It use the two pass construction CellList::fill, giving the same result of
+ * populate_cell_list_no_sym or populate_cell_list_sym without reallocations
  *
  * \tparam dim dimensionality of the space
  * \tparam T type of the space
@@ -74,10 +103,7 @@ template<unsigned int dim, typename T, typename CellList> void populate_cell_lis
  */
 template<unsigned int dim, typename T, typename CellList> void populate_cell_list(openfpm::vector<Point<dim,T>> & pos, CellList & cli, size_t g_m, size_t opt)
 {
-	if (opt == CL_NON_SYMMETRIC)
-		populate_cell_list_no_sym(pos,cli,g_m);
-	else
-		populate_cell_list_sym(pos,cli,g_m);
+	cli.fill(pos,g_m,opt);
 }
 
 /*! \brief Structure that contain a reference to a vector of particles
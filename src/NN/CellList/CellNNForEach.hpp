@@ -0,0 +1,149 @@
+/*
+ * CellNNForEach.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_CELLNNFOREACH_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_CELLNNFOREACH_HPP_
+
+#include "NN/CellList/CellNNIterator.hpp"
+
+/*! \brief Select the neighborhood offsets of a Cell-list from the stencil size
+ *
+ * FULL use the full neighborhood, SYM and CRS use the symmetric neighborhood (the CRS
+ * scheme use the symmetric neighborhood on the domain cells, see ParticleItCRS_Cells)
+ *
+ * \tparam dim dimensionality
+ * \tparam stencil FULL, SYM or CRS
+ *
+ */
+template<unsigned int dim, int stencil, bool is_full = (stencil == (int)openfpm::math::pow(3,dim))>
+struct NNc_stencil_sel
+{
+	//! Number of neighborhood cells
+	static const unsigned int size = openfpm::math::pow(3,dim);
+
+	/*! \brief Get the neighborhood offsets
+	 *
+	 * \param cl Cell-list
+	 *
+	 * \return the neighborhood offsets
+	 *
+	 */
+	template<typename CellList_type> static inline auto get(const CellList_type & cl) -> decltype(cl.getNNc_full())
+	{
+		return cl.getNNc_full();
+	}
+};
+
+/*! \brief Select the neighborhood offsets of a Cell-list from the stencil size
+ *
+ * Symmetric and CRS case
+ *
+ * \tparam dim dimensionality
+ * \tparam stencil SYM or CRS
+ *
+ */
+template<unsigned int dim, int stencil>
+struct NNc_stencil_sel<dim,stencil,false>
+{
+	static_assert(stencil == (int)(openfpm::math::pow(3,dim)/2+1) || stencil == (int)openfpm::math::pow(2,dim),
+			      "stencil must be FULL, SYM or CRS");
+
+	//! Number of neighborhood cells
+	static const unsigned int size = openfpm::math::pow(3,dim)/2+1;
+
+	/*! \brief Get the neighborhood offsets
+	 *
+	 * \param cl Cell-list
+	 *
+	 * \return the neighborhood offsets
+	 *
+	 */
+	template<typename CellList_type> static inline auto get(const CellList_type & cl) -> decltype(cl.getNNc_sym())
+	{
+		return cl.getNNc_sym();
+	}
+};
+
+/*! \brief Compile-time unrolled loop over the neighborhood cells
+ *
+ * \tparam i neighborhood cell to process
+ * \tparam N number of neighborhood cells
+ *
+ */
+template<unsigned int i, unsigned int N>
+struct for_each_neighbor_unroll
+{
+	/*! \brief Call the functor on the neighborhood cell i and continue with the next
+	 *
+	 * \param cl Cell-list
+	 * \param NNc neighborhood offsets
+	 * \param cell center cell
+	 * \param f functor
+	 *
+	 */
+	template<typename CellList_type, typename NNc_type, typename Functor>
+	static inline void run(const CellList_type & cl, const NNc_type & NNc, long int cell, Functor & f)
+	{
+		size_t c = NNc[i] + cell;
+
+		f(&cl.getStartId(c),&cl.getStopId(c));
+
+		for_each_neighbor_unroll<i+1,N>::run(cl,NNc,cell,f);
+	}
+};
+
+/*! \brief Compile-time unrolled loop over the neighborhood cells
+ *
+ * End of the loop
+ *
+ * \tparam N number of neighborhood cells
+ *
+ */
+template<unsigned int N>
+struct for_each_neighbor_unroll<N,N>
+{
+	/*! \brief End of the loop, do nothing
+	 *
+	 * \param cl Cell-list
+	 * \param NNc neighborhood offsets
+	 * \param cell center cell
+	 * \param f functor
+	 *
+	 */
+	template<typename CellList_type, typename NNc_type, typename Functor>
+	static inline void run(const CellList_type & cl, const NNc_type & NNc, long int cell, Functor & f)
+	{}
+};
+
+/*! \brief Call a functor on each cell of the neighborhood of a cell
+ *
+ * Unlike the CellNNIterator the loop over the neighborhood cells is unrolled at compile-time
+ * and the functor receive the full range of the particles in the cell (empty cells included)
+ *
+ * \code
+ * f(const loc_index * start, const loc_index * stop)
+ * \endcode
+ *
+ * \snippet CellList_test.hpp Usage of for_each_neighbor
+ *
+ * \tparam dim dimensionality
+ * \tparam stencil FULL, SYM or CRS
+ *
+ * \param cl Cell-list
+ * \param cell center cell
+ * \param f functor
+ *
+ */
+template<unsigned int dim, int stencil, typename CellList_type, typename Functor>
+inline void for_each_neighbor(const CellList_type & cl, size_t cell, Functor f)
+{
+	typedef NNc_stencil_sel<dim,stencil> sel;
+
+	for_each_neighbor_unroll<0,sel::size>::run(cl,sel::get(cl),cell,f);
+}
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLNNFOREACH_HPP_ */
@@ -30,7 +30,7 @@
 template<unsigned int dim, typename Cell, unsigned int sh_byte, int NNc_size, unsigned int impl>
 class CellNNIteratorSymM : public CellNNIterator<dim,Cell,NNc_size,impl>
 {
-	typedef boost::low_bits_mask_t<sizeof(size_t)*8-sh_byte>  mask_low;
+	typedef boost::low_bits_mask_t<sizeof(typename Cell::Mem_type_type::loc_index)*8-sh_byte>  mask_low;
 
 	//! phase of particle p
 	size_t pp;
@@ -56,12 +56,12 @@ class CellNNIteratorSymM : public CellNNIterator<dim,Cell,NNc_size,impl>
 				size_t q = this->cl.get_lin(this->start_id);
 				for (long int i = dim-1 ; i >= 0 ; i--)
 				{
-					if (pos.template get<0>(p)[i] < ps.get(q >> (sizeof(size_t)*8-sh_byte)).pos.template get<0>(q & mask_low::sig_bits_fast)[i])
+					if (pos.template get<0>(p)[i] < ps.get(q >> (sizeof(typename Cell::Mem_type_type::loc_index)*8-sh_byte)).pos.template get<0>(q & mask_low::sig_bits_fast)[i])
 						return;
-					else if (pos.template get<0>(p)[i] > ps.get(q >> (sizeof(size_t)*8-sh_byte)).pos.template get<0>(q & mask_low::sig_bits_fast)[i])
+					else if (pos.template get<0>(p)[i] > ps.get(q >> (sizeof(typename Cell::Mem_type_type::loc_index)*8-sh_byte)).pos.template get<0>(q & mask_low::sig_bits_fast)[i])
 						goto next;
 				}
-				if (q >> (sizeof(size_t)*8-sh_byte) != pp)	return;
+				if (q >> (sizeof(typename Cell::Mem_type_type::loc_index)*8-sh_byte) != pp)	return;
 				if ((q & mask_low::sig_bits_fast) >= p)	return;
 next:
 				this->start_id++;
@@ -116,7 +116,7 @@ public:
 	 */
 	inline size_t getV()
 	{
-		return (CellNNIterator<dim,Cell,NNc_size,impl>::get()) >> (sizeof(size_t)*8-sh_byte);
+		return (CellNNIterator<dim,Cell,NNc_size,impl>::get()) >> (sizeof(typename Cell::Mem_type_type::loc_index)*8-sh_byte);
 	}
 
 	/*! \brief take the next element
@@ -148,7 +148,7 @@ public:
  */
 template<unsigned int dim, typename Cell, unsigned int sh_byte, int NNc_size, unsigned int impl> class CellNNIteratorM : public CellNNIterator<dim,Cell,NNc_size,impl>
 {
-	typedef boost::low_bits_mask_t<sizeof(size_t)*8-sh_byte>  mask_low;
+	typedef boost::low_bits_mask_t<sizeof(typename Cell::Mem_type_type::loc_index)*8-sh_byte>  mask_low;
 
 public:
 
@@ -183,7 +183,7 @@ public:
 	 */
 	inline size_t getV()
 	{
-		return (CellNNIterator<dim,Cell,NNc_size,impl>::get()) >> (sizeof(size_t)*8-sh_byte);
+		return (CellNNIterator<dim,Cell,NNc_size,impl>::get()) >> (sizeof(typename Cell::Mem_type_type::loc_index)*8-sh_byte);
 	}
 };
 
@@ -197,7 +197,7 @@ public:
 template<typename Cell, unsigned int sh_byte> class CellIteratorM : public CellIterator<Cell>
 {
 
-	typedef boost::low_bits_mask_t<sizeof(size_t)*8-sh_byte>  mask_low;
+	typedef boost::low_bits_mask_t<sizeof(typename Cell::Mem_type_type::loc_index)*8-sh_byte>  mask_low;
 
 public:
 
@@ -228,7 +228,7 @@ public:
 	 */
 	inline size_t getV()
 	{
-		return (CellIterator<Cell>::get()) >> (sizeof(size_t)*8-sh_byte);
+		return (CellIterator<Cell>::get()) >> (sizeof(typename Cell::Mem_type_type::loc_index)*8-sh_byte);
 	}
 };
 
@@ -0,0 +1,251 @@
+/*
+ * CellNNIteratorMPhase.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_CELLNNITERATORMPHASE_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_CELLNNITERATORMPHASE_HPP_
+
+#include "CellList_util.hpp"
+#include "CellNNIterator.hpp"
+
+/*! \brief Iterator for the neighborhood of a multi-phase cell list with one Cell-list for each phase
+ *
+ * In general you never create it directly but you get it from CellListMPhase
+ *
+ * For each neighborhood cell it iterate the particles of all the phases (phase 0 first), the
+ * particle id and the phase are read directly without unpacking
+ *
+ * \tparam dim dimensionality of the space where the cell live
+ * \tparam Cell multi-phase cell list
+ * \tparam NNc_size neighborhood size
+ * \tparam impl implementation specific options NO_CHECK do not do check on access, SAFE do check on access
+ *
+ */
+template<unsigned int dim, typename Cell, int NNc_size, unsigned int impl>
+class CellNNIteratorMPhase
+{
+protected:
+
+	//! actual element id
+	const typename Cell::Mem_type_type::loc_index * start_id;
+
+	//! stop id to read the end of the cell
+	const typename Cell::Mem_type_type::loc_index * stop_id;
+
+	//! Actual NNc_id;
+	size_t NNc_id;
+
+	//! actual phase
+	size_t v;
+
+	//! Center cell, or cell for witch we are searching the NN-cell
+	const long int cell;
+
+	//! Cell list
+	Cell & cl;
+
+	//! NN cell id
+	const NNc_array<dim,NNc_size> & NNc;
+
+	/*! \brief Set start_id and stop_id for the actual cell and phase
+	 *
+	 */
+	inline void setCell()
+	{
+		size_t cell_id = NNc[NNc_id] + cell;
+
+		start_id = &cl.getPhase(v).getStartId(cell_id);
+		stop_id = &cl.getPhase(v).getStopId(cell_id);
+	}
+
+	/*! \brief Select non-empty cell
+	 *
+	 */
+	inline void selectValid()
+	{
+		while (start_id == stop_id)
+		{
+			v++;
+
+			if (v >= cl.getNPhases())
+			{
+				v = 0;
+				NNc_id++;
+
+				// No more Cell
+				if (NNc_id >= NNc_size) return;
+			}
+
+			setCell();
+		}
+	}
+
+public:
+
+	/*! \brief Cell NN iterator
+	 *
+	 * \param cell Cell id
+	 * \param NNc Cell neighborhood indexes (relative)
+	 * \param cl Cell structure
+	 *
+	 */
+	inline CellNNIteratorMPhase(size_t cell, const NNc_array<dim,NNc_size> & NNc, Cell & cl)
+	:NNc_id(0),v(0),cell(cell),cl(cl),NNc(NNc)
+	{
+		setCell();
+		selectValid();
+	}
+
+	/*! \brief Check if there is the next element
+	 *
+	 * \return true if there is the next element
+	 *
+	 */
+	inline bool isNext()
+	{
+		if (NNc_id >= NNc_size)
+			return false;
+		return true;
+	}
+
+	/*! \brief take the next element
+	 *
+	 * \return itself
+	 *
+	 */
+	inline CellNNIteratorMPhase & operator++()
+	{
+		start_id++;
+
+		selectValid();
+
+		return *this;
+	}
+
+	/*! \brief Get the particle id
+	 *
+	 * \return the particle id
+	 *
+	 */
+	inline typename Cell::Mem_type_type::loc_index getP()
+	{
+		return cl.getPhase(v).get_lin(start_id);
+	}
+
+	/*! \brief Get the phase of the particle
+	 *
+	 * \return the phase
+	 *
+	 */
+	inline size_t getV()
+	{
+		return v;
+	}
+};
+
+/*! \brief Symmetric iterator for the neighborhood of a multi-phase cell list with one Cell-list for each phase
+ *
+ * In general you never create it directly but you get it from CellListMPhase
+ *
+ * In the center cell only the particles that follow p are visited (ordered by position,
+ * then by phase and id) like CellNNIteratorSymM
+ *
+ * \tparam dim dimensionality of the space where the cell live
+ * \tparam Cell multi-phase cell list
+ * \tparam NNc_size neighborhood size
+ * \tparam impl implementation specific options NO_CHECK do not do check on access, SAFE do check on access
+ *
+ */
+template<unsigned int dim, typename Cell, int NNc_size, unsigned int impl>
+class CellNNIteratorSymMPhase : public CellNNIteratorMPhase<dim,Cell,NNc_size,impl>
+{
+	//! phase of particle p
+	size_t pp;
+
+	//! index of the particle p
+	size_t p;
+
+	//! Position of the particles p
+	const openfpm::vector<Point<dim,typename Cell::stype>> & pos;
+
+	//! Position of the particles of all the phases
+	const openfpm::vector<pos_v<dim,typename Cell::stype>> & ps;
+
+	/*! Select the next valid element
+	 *
+	 */
+	inline void selectValid()
+	{
+		while (this->NNc_id < NNc_size)
+		{
+			CellNNIteratorMPhase<dim,Cell,NNc_size,impl>::selectValid();
+
+			if (this->NNc_id >= NNc_size || this->NNc[this->NNc_id] != 0)
+				return;
+
+			// center cell, skip the particles that come before p
+
+			while (this->start_id < this->stop_id)
+			{
+				size_t q = this->cl.getPhase(this->v).get_lin(this->start_id);
+				size_t vq = this->v;
+
+				for (long int i = dim-1 ; i >= 0 ; i--)
+				{
+					if (pos.template get<0>(p)[i] < ps.get(vq).pos.template get<0>(q)[i])
+						return;
+					else if (pos.template get<0>(p)[i] > ps.get(vq).pos.template get<0>(q)[i])
+						goto next;
+				}
+				if (vq != pp)	return;
+				if (q >= p)	return;
+next:
+				this->start_id++;
+			}
+		}
+	}
+
+public:
+
+	/*! \brief Cell NN iterator
+	 *
+	 * \param cell Cell id
+	 * \param pp phase of the particle p
+	 * \param p particle id
+	 * \param NNc Cell neighborhood indexes (relative)
+	 * \param cl Cell structure
+	 * \param pos position of the particles of the phase pp
+	 * \param ps position of the particles of all the phases
+	 *
+	 */
+	inline CellNNIteratorSymMPhase(size_t cell,
+			                       size_t pp,
+			                       size_t p,
+			                       const NNc_array<dim,NNc_size> & NNc,
+			                       Cell & cl,
+			                       const openfpm::vector<Point<dim,typename Cell::stype>> & pos,
+			                       const openfpm::vector<pos_v<dim,typename Cell::stype>> & ps)
+	:CellNNIteratorMPhase<dim,Cell,NNc_size,impl>(cell,NNc,cl),pp(pp),p(p),pos(pos),ps(ps)
+	{
+		selectValid();
+	}
+
+	/*! \brief take the next element
+	 *
+	 * \return itself
+	 *
+	 */
+	inline CellNNIteratorSymMPhase & operator++()
+	{
+		this->start_id++;
+
+		selectValid();
+
+		return *this;
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLNNITERATORMPHASE_HPP_ */
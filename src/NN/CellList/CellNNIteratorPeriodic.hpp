@@ -0,0 +1,171 @@
+/*
+ * CellNNIteratorPeriodic.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_CELLNNITERATORPERIODIC_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_CELLNNITERATORPERIODIC_HPP_
+
+#include "Grid/grid_sm.hpp"
+#include "Space/Shape/Point.hpp"
+
+/*! \brief Iterator for the neighborhood of a cell in a periodic domain without ghost particles
+ *
+ * In general you never create it directly but you get it from CellList::getNNIteratorPeriodic
+ *
+ * The neighborhood cells that fall outside the domain are wrapped on the other side of
+ * the domain, together with the particle id the iterator return the shift vector to add to
+ * the position of the particle to get its image near the center cell
+ *
+ * \note the Cell-list must contain only the domain particles (inside the box) and must have
+ *       at least 3 divisions in each direction, otherwise a cell is visited more than one time
+ *
+ * \tparam dim dimensionality of the space where the cell live
+ * \tparam Cell cell type on which the iterator is working
+ * \tparam impl implementation specific options NO_CHECK do not do check on access, SAFE do check on access
+ *
+ */
+template<unsigned int dim, typename Cell, unsigned int impl>
+class CellNNIteratorPeriodic
+{
+	//! actual element id
+	const typename Cell::Mem_type_type::loc_index * start_id;
+
+	//! stop id to read the end of the cell
+	const typename Cell::Mem_type_type::loc_index * stop_id;
+
+	//! Actual neighborhood cell (from 0 to 3^dim)
+	size_t NNc_id;
+
+	//! Center cell
+	grid_key_dx<dim> center;
+
+	//! shift of the actual neighborhood cell
+	Point<dim,typename Cell::stype> shift;
+
+	//! Cell list
+	Cell & cl;
+
+	/*! \brief Set start_id, stop_id and the shift for the actual neighborhood cell
+	 *
+	 */
+	inline void setCell()
+	{
+		const grid_sm<dim,void> & gs = cl.getGrid();
+
+		grid_key_dx<dim> k;
+		size_t c = NNc_id;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			long int lo = cl.getPadding(i);
+			long int n = gs.size(i) - 2*cl.getPadding(i);
+
+			long int ki = center.get(i) + (long int)(c % 3) - 1;
+			c /= 3;
+
+			shift.get(i) = 0;
+
+			if (ki < lo)
+			{
+				ki += n;
+				shift.get(i) = -n * cl.getCellBox().getHigh(i);
+			}
+			else if (ki >= lo + n)
+			{
+				ki -= n;
+				shift.get(i) = n * cl.getCellBox().getHigh(i);
+			}
+
+			k.set_d(i,ki);
+		}
+
+		size_t cell_id = gs.LinId(k);
+
+		start_id = &cl.getStartId(cell_id);
+		stop_id = &cl.getStopId(cell_id);
+	}
+
+	/*! \brief Select non-empty cell
+	 *
+	 */
+	inline void selectValid()
+	{
+		while (start_id == stop_id)
+		{
+			NNc_id++;
+
+			// No more Cell
+			if (NNc_id >= openfpm::math::pow(3,dim)) return;
+
+			setCell();
+		}
+	}
+
+public:
+
+	/*! \brief Cell NN iterator
+	 *
+	 * \param cell Cell id (must be a domain cell)
+	 * \param cl Cell structure
+	 *
+	 */
+	inline CellNNIteratorPeriodic(size_t cell, Cell & cl)
+	:NNc_id(0),cl(cl)
+	{
+		center = cl.getGrid().InvLinId(cell);
+
+		setCell();
+		selectValid();
+	}
+
+	/*! \brief Check if there is the next element
+	 *
+	 * \return true if there is the next element
+	 *
+	 */
+	inline bool isNext()
+	{
+		if (NNc_id >= openfpm::math::pow(3,dim))
+			return false;
+		return true;
+	}
+
+	/*! \brief take the next element
+	 *
+	 * \return itself
+	 *
+	 */
+	inline CellNNIteratorPeriodic & operator++()
+	{
+		start_id++;
+
+		selectValid();
+
+		return *this;
+	}
+
+	/*! \brief Get the particle id
+	 *
+	 * \return the particle id
+	 *
+	 */
+	inline const typename Cell::Mem_type_type::loc_index & get()
+	{
+		return cl.get_lin(start_id);
+	}
+
+	/*! \brief Get the shift to apply to the particle position to get its periodic image
+	 *
+	 * \return the shift vector
+	 *
+	 */
+	inline const Point<dim,typename Cell::stype> & getShift()
+	{
+		return shift;
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLNNITERATORPERIODIC_HPP_ */
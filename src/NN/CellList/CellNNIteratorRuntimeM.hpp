@@ -25,7 +25,7 @@
 template<unsigned int dim, typename Cell, unsigned int sh_byte, unsigned int impl>
 class CellNNIteratorM<dim,Cell,sh_byte,RUNTIME,impl> : public CellNNIterator<dim,Cell,RUNTIME,impl>
 {
-	typedef boost::low_bits_mask_t<sizeof(size_t)*8-sh_byte>  mask_low;
+	typedef boost::low_bits_mask_t<sizeof(typename Cell::Mem_type_type::loc_index)*8-sh_byte>  mask_low;
 
 public:
 
@@ -60,7 +60,7 @@ public:
 	 */
 	inline size_t getV()
 	{
-		return (CellNNIterator<dim,Cell,RUNTIME,impl>::get()) >> (sizeof(size_t)*8-sh_byte);
+		return (CellNNIterator<dim,Cell,RUNTIME,impl>::get()) >> (sizeof(typename Cell::Mem_type_type::loc_index)*8-sh_byte);
 	}
 };
 
@@ -84,7 +84,7 @@ public:
 template<unsigned int dim, typename Cell, unsigned int sh_byte, unsigned int impl>
 class CellNNIteratorSymM<dim,Cell,sh_byte,RUNTIME,impl> : public CellNNIterator<dim,Cell,RUNTIME,impl>
 {
-	typedef boost::low_bits_mask_t<sizeof(size_t)*8-sh_byte>  mask_low;
+	typedef boost::low_bits_mask_t<sizeof(typename Cell::Mem_type_type::loc_index)*8-sh_byte>  mask_low;
 
 	//! phase of the particle p
 	size_t pp;
@@ -109,12 +109,12 @@ class CellNNIteratorSymM<dim,Cell,sh_byte,RUNTIME,impl> : public CellNNIterator<
 				size_t q = this->cl.get_lin(this->start_id);
 				for (long int i = dim-1 ; i >= 0 ; i--)
 				{
-					if (pos.template get<0>(p)[i] < ps.get(q >> (sizeof(size_t)*8-sh_byte)).pos.template get<0>(q & mask_low::sig_bits_fast)[i])
+					if (pos.template get<0>(p)[i] < ps.get(q >> (sizeof(typename Cell::Mem_type_type::loc_index)*8-sh_byte)).pos.template get<0>(q & mask_low::sig_bits_fast)[i])
 						return;
-					else if (pos.template get<0>(p)[i] > ps.get(q >> (sizeof(size_t)*8-sh_byte)).pos.template get<0>(q & mask_low::sig_bits_fast)[i])
+					else if (pos.template get<0>(p)[i] > ps.get(q >> (sizeof(typename Cell::Mem_type_type::loc_index)*8-sh_byte)).pos.template get<0>(q & mask_low::sig_bits_fast)[i])
 						goto next;
 				}
-				if (q >> (sizeof(size_t)*8-sh_byte) != pp)	return;
+				if (q >> (sizeof(typename Cell::Mem_type_type::loc_index)*8-sh_byte) != pp)	return;
 				if ((q & mask_low::sig_bits_fast) >= p)	return;
 next:
 				this->start_id++;
@@ -168,7 +168,7 @@ public:
 	 */
 	inline size_t getV()
 	{
-		return (CellNNIterator<dim,Cell,RUNTIME,impl>::get()) >> (sizeof(size_t)*8-sh_byte);
+		return (CellNNIterator<dim,Cell,RUNTIME,impl>::get()) >> (sizeof(typename Cell::Mem_type_type::loc_index)*8-sh_byte);
 	}
 
 	/*! \brief take the next element
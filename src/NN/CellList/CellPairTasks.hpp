@@ -0,0 +1,212 @@
+/*
+ * CellPairTasks.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_CELLPAIRTASKS_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_CELLPAIRTASKS_HPP_
+
+#include "NN/CellList/CellList.hpp"
+#include "NN/CellList/ParticleItCRS_Cells.hpp"
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*! \brief Interaction task between the particles of two cells
+ *
+ * If cell_a == cell_b the task is the interaction of the particles of the cell with themselves
+ *
+ */
+struct cell_pair_task
+{
+	//! first cell
+	size_t cell_a;
+
+	//! second cell
+	size_t cell_b;
+
+	//! estimated cost (number of particle couples)
+	size_t cost;
+
+	/*! \brief Order the tasks by decreasing cost
+	 *
+	 * \param t task to compare
+	 *
+	 * \return true if this task is more expensive than t
+	 *
+	 */
+	bool operator<(const cell_pair_task & t) const
+	{
+		return cost > t.cost;
+	}
+};
+
+/*! \brief Add the tasks of a cell with its (relative) neighborhood cells
+ *
+ * \param cl Cell-list
+ * \param cell cell
+ * \param NNc relative neighborhood cells (0 is the cell itself)
+ * \param n_NNc number of neighborhood cells
+ * \param tasks where to add the tasks
+ *
+ */
+template<typename CellList_type, typename NNc_type>
+inline void add_cell_pair_tasks(CellList_type & cl, size_t cell, const NNc_type & NNc, size_t n_NNc, openfpm::vector<cell_pair_task> & tasks)
+{
+	size_t n_a = cl.getNelements(cell);
+
+	if (n_a == 0)
+		return;
+
+	for (size_t k = 0 ; k < n_NNc ; k++)
+	{
+		size_t cell_b = cell + NNc[k];
+		size_t n_b = cl.getNelements(cell_b);
+
+		size_t cost = (cell_b == cell)?n_a*(n_a-1)/2:n_a*n_b;
+
+		if (cost == 0)
+			continue;
+
+		tasks.add();
+		tasks.last().cell_a = cell;
+		tasks.last().cell_b = cell_b;
+		tasks.last().cost = cost;
+	}
+}
+
+/*! \brief Generate the list of symmetric cell-pair tasks for a CRS traversal
+ *
+ * For every cell in dom the tasks with the symmetric neighborhood of the Cell-list are
+ * generated, for every cell in anom the tasks with the neighborhood listed in NN_subsub.
+ * Every couple of cells appears only once, empty tasks are skipped and the tasks are sorted
+ * by decreasing cost (n_a * n_b, or n_a * (n_a - 1) / 2 when cell_a == cell_b), so that
+ * a dynamic scheduler starting from the head of the list execute the big tasks first
+ *
+ * \param cl Cell-list
+ * \param dom list of cells with normal neighborhood
+ * \param anom list of cells with non-normal neighborhood
+ * \param tasks output list of tasks
+ *
+ */
+template<unsigned int dim, typename CellList_type>
+void cell_pair_tasks(CellList_type & cl, const openfpm::vector<size_t> & dom, const openfpm::vector<subsub_lin<dim>> & anom, openfpm::vector<cell_pair_task> & tasks)
+{
+	tasks.clear();
+
+	const auto & NNc = cl.getNNc_sym();
+
+	for (size_t i = 0 ; i < dom.size() ; i++)
+		add_cell_pair_tasks(cl,dom.get(i),NNc,openfpm::math::pow(3,dim)/2+1,tasks);
+
+	for (size_t i = 0 ; i < anom.size() ; i++)
+	{
+		if (anom.get(i).NN_subsub.size() != 0)
+			add_cell_pair_tasks(cl,anom.get(i).subsub,&anom.get(i).NN_subsub.get(0),anom.get(i).NN_subsub.size(),tasks);
+	}
+
+	if (tasks.size() != 0)
+		std::sort(&tasks.get(0),&tasks.get(0) + tasks.size());
+}
+
+/*! \brief Generate the list of symmetric cell-pair tasks for all the domain cells
+ *
+ * Same as cell_pair_tasks with the list of cells but all the cells that are not padding
+ * are used with the symmetric neighborhood (the Cell-list must have at least one padding cell)
+ *
+ * \param cl Cell-list
+ * \param tasks output list of tasks
+ *
+ */
+template<unsigned int dim, typename CellList_type>
+void cell_pair_tasks(CellList_type & cl, openfpm::vector<cell_pair_task> & tasks)
+{
+	tasks.clear();
+
+	const grid_sm<dim,void> & gs = cl.getGrid();
+	const auto & NNc = cl.getNNc_sym();
+
+	grid_key_dx<dim> start;
+	grid_key_dx<dim> stop;
+
+	for (size_t i = 0 ; i < dim ; i++)
+	{
+		start.set_d(i,cl.getPadding(i));
+		stop.set_d(i,gs.size(i) - cl.getPadding(i) - 1);
+	}
+
+	grid_key_dx_iterator_sub<dim> it(gs,start,stop);
+
+	while (it.isNext())
+	{
+		add_cell_pair_tasks(cl,gs.LinId(it.get()),NNc,openfpm::math::pow(3,dim)/2+1,tasks);
+
+		++it;
+	}
+
+	if (tasks.size() != 0)
+		std::sort(&tasks.get(0),&tasks.get(0) + tasks.size());
+}
+
+/*! \brief Distribute a list of tasks sorted by decreasing cost across n_bin bins
+ *
+ * Every task is assigned to the bin with the lowest load (longest processing time first),
+ * the load of the biggest bin is at most the average load plus the cost of one task
+ *
+ * \param tasks tasks sorted by decreasing cost
+ * \param n_bin number of bins (for example the number of threads)
+ * \param bins for each bin the list of the tasks assigned
+ * \param load for each bin the total cost
+ *
+ */
+inline void cell_pair_tasks_bin(const openfpm::vector<cell_pair_task> & tasks, size_t n_bin, openfpm::vector<openfpm::vector<size_t>> & bins, openfpm::vector<size_t> & load)
+{
+	bins.resize(n_bin);
+	load.resize(n_bin);
+
+	for (size_t b = 0 ; b < n_bin ; b++)
+	{
+		bins.get(b).clear();
+		load.get(b) = 0;
+	}
+
+	for (size_t t = 0 ; t < tasks.size() ; t++)
+	{
+		size_t b_min = 0;
+
+		for (size_t b = 1 ; b < n_bin ; b++)
+		{
+			if (load.get(b) < load.get(b_min))
+				b_min = b;
+		}
+
+		bins.get(b_min).add(t);
+		load.get(b_min) += tasks.get(t).cost;
+	}
+}
+
+/*! \brief Execute a list of cell-pair tasks
+ *
+ * With OpenMP the tasks are distributed dynamically one by one, because the list is sorted
+ * by decreasing cost the expensive tasks are executed first and the cheap one fill the gaps.
+ * The functor is called as f(const cell_pair_task & t), tasks executed in parallel can share
+ * a cell, so the functor must not write on the particles without synchronization
+ *
+ * \param tasks tasks sorted by decreasing cost
+ * \param f functor
+ *
+ */
+template<typename Functor>
+void for_each_cell_pair_task(const openfpm::vector<cell_pair_task> & tasks, Functor f)
+{
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(dynamic,1)
+#endif
+	for (size_t t = 0 ; t < tasks.size() ; t++)
+		f(tasks.get(t));
+}
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLPAIRTASKS_HPP_ */
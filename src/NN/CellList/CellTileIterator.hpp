@@ -0,0 +1,199 @@
+/*
+ * CellTileIterator.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_CELLLIST_CELLTILEITERATOR_HPP_
+#define OPENFPM_DATA_SRC_NN_CELLLIST_CELLTILEITERATOR_HPP_
+
+#include "Grid/grid_sm.hpp"
+#include <cmath>
+
+//! Default size of the cache used to choose the tiles (L2)
+#define CELL_TILE_CACHE_SIZE 262144
+
+/*! \brief Iterator across the domain cells of a Cell-list grouped in tiles
+ *
+ * The domain cells (padding excluded) are divided in tiles, all the cells of a tile are visited
+ * (in linear order) before moving to the next tile. If a tile with its neighborhood fit the
+ * cache, the neighborhood cells of a center are reused by the next centers instead of
+ * being reloaded from memory at every z-plane as happen with the linear order.
+ *
+ * \tparam dim dimensionality
+ *
+ */
+template<unsigned int dim>
+class CellTileIterator
+{
+	//! grid of the cells (padding included)
+	const grid_sm<dim,void> & gs;
+
+	//! padding
+	size_t pad[dim];
+
+	//! size of the tile
+	size_t tile[dim];
+
+	//! iterator across the tiles
+	grid_key_dx_iterator<dim> t_it;
+
+	//! grid of the tiles
+	grid_sm<dim,void> gt;
+
+	//! iterator inside the tile
+	grid_key_dx_iterator_sub<dim> c_it;
+
+	/*! \brief Set the iterator inside the actual tile
+	 *
+	 */
+	void setTile()
+	{
+		grid_key_dx<dim> start;
+		grid_key_dx<dim> stop;
+
+		grid_key_dx<dim> t = t_it.get();
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			long int s = pad[i] + t.get(i) * tile[i];
+			long int e = s + tile[i] - 1;
+			long int e_max = gs.size(i) - pad[i] - 1;
+
+			start.set_d(i,s);
+			stop.set_d(i,(e > e_max)?e_max:e);
+		}
+
+		c_it.reinitialize(grid_key_dx_iterator_sub<dim>(gs,start,stop));
+	}
+
+	/*! \brief Calculate the grid of the tiles
+	 *
+	 * \param gs grid of the cells
+	 * \param pad padding
+	 * \param tile size of the tile
+	 *
+	 * \return the grid of the tiles
+	 *
+	 */
+	static grid_sm<dim,void> tile_grid(const grid_sm<dim,void> & gs, const size_t (& pad)[dim], const size_t (& tile)[dim])
+	{
+		size_t sz[dim];
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			size_t n = gs.size(i) - 2*pad[i];
+			sz[i] = (n + tile[i] - 1) / tile[i];
+		}
+
+		return grid_sm<dim,void>(sz);
+	}
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param gs grid of the cells (padding included)
+	 * \param pad padding in each direction
+	 * \param tile size of the tile in each direction
+	 *
+	 */
+	CellTileIterator(const grid_sm<dim,void> & gs, const size_t (& pad)[dim], const size_t (& tile)[dim])
+	:gs(gs),gt(tile_grid(gs,pad,tile))
+	{
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			this->pad[i] = pad[i];
+			this->tile[i] = tile[i];
+		}
+
+		t_it.reinitialize(grid_key_dx_iterator<dim>(gt));
+
+		if (t_it.isNext())
+			setTile();
+	}
+
+	/*! \brief Check if there is the next cell
+	 *
+	 * \return true if there is the next cell
+	 *
+	 */
+	bool isNext()
+	{
+		return t_it.isNext();
+	}
+
+	/*! \brief Go to the next cell
+	 *
+	 * \return itself
+	 *
+	 */
+	CellTileIterator<dim> & operator++()
+	{
+		++c_it;
+
+		if (c_it.isNext() == false)
+		{
+			++t_it;
+
+			if (t_it.isNext())
+				setTile();
+		}
+
+		return *this;
+	}
+
+	/*! \brief Get the actual cell
+	 *
+	 * \return the cell-id
+	 *
+	 */
+	size_t getCell()
+	{
+		return gs.LinId(c_it.get());
+	}
+
+	/*! \brief Get the actual cell as grid key
+	 *
+	 * \return the grid key of the cell
+	 *
+	 */
+	grid_key_dx<dim> get()
+	{
+		return c_it.get();
+	}
+
+	/*! \brief Calculate the size of the tiles
+	 *
+	 * The tile is as cubic as possible and such that the particles of the tile, with one
+	 * layer of neighborhood cells, fit the cache
+	 *
+	 * \param gs grid of the cells (padding included)
+	 * \param pad padding in each direction
+	 * \param occ average number of particles in a cell
+	 * \param part_size bytes read for each particle (id and position)
+	 * \param cache_size size of the cache in bytes
+	 * \param tile output size of the tile
+	 *
+	 */
+	static void calculateTile(const grid_sm<dim,void> & gs, const size_t (& pad)[dim], double occ, size_t part_size, size_t cache_size, size_t (& tile)[dim])
+	{
+		occ = (occ < 1.0)?1.0:occ;
+
+		// number of cells that fit the cache (halo included)
+		double n_fit = cache_size / (occ * part_size);
+
+		long int t = std::floor(std::pow(n_fit,1.0/dim)) - 2;
+		t = (t < 1)?1:t;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{
+			size_t n = gs.size(i) - 2*pad[i];
+			tile[i] = ((size_t)t > n)?n:t;
+			tile[i] = (tile[i] == 0)?1:tile[i];
+		}
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_NN_CELLLIST_CELLTILEITERATOR_HPP_ */
@@ -69,6 +69,25 @@ public:
 		clear();
 	}
 
+	/*! \brief Initialize the data structure from the number of elements each cell will store
+	 *
+	 * Each cell reserve exactly the space for its elements, so adding the counted
+	 * elements never reallocate
+	 *
+	 * \param cnt number of elements for each cell
+	 *
+	 */
+	inline void init_to_count(const openfpm::vector<local_index> & cnt)
+	{
+		cl_base.resize(cnt.size());
+
+		for (size_t i = 0 ; i < cl_base.size() ; i++)
+		{
+			cl_base.get(i).clear();
+			cl_base.get(i).reserve(cnt.get(i));
+		}
+	}
+
 	/*! \brief Copy mem balanced
 	 *
 	 * \param cell memory to copy
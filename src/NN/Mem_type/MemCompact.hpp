@@ -0,0 +1,415 @@
+/*
+ * MemCompact.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef MEMCOMPACT_HPP_
+#define MEMCOMPACT_HPP_
+
+#include "Vector/map_vector.hpp"
+
+//! Minimum number of free slots each cell get when the structure is reorganized
+#define MEM_COMPACT_MIN_SLACK 4
+
+/*! \brief Class for COMPACT cell list implementation
+ *
+ * \tparam local_index type used for the local index
+ *
+ * The elements of all the cells are packed in a single array one cell after the other,
+ * and an array of offsets store where each cell start (Compressed Sparse Row format).
+ * The memory allocation is (in byte) Size = M*2*sizeof(local_index) + N*sizeof(ele)
+ *
+ * Where
+ *
+ * * N = total number of elements
+ * * M = number of cells
+ * * ele = element the structure is storing
+ *
+ * Unlike Mem_fast the memory does not depend on the most populated cell, so it is the
+ * best choice for highly asymmetric distributions.
+ *
+ * \note The structure is designed to be filled with the counting-sort construction
+ *       (init_to_count() followed by the add of the counted elements, see CellList::fill) or
+ *       by adding the elements ordered by cell (like the Verlet-list construction). In both cases no
+ *       reallocation happen. Adding in a cell that is already full reorganize the
+ *       full structure doubling the space of each cell plus MEM_COMPACT_MIN_SLACK free slots,
+ *       so also the empty cells can receive elements without a new reorganization
+ *
+ */
+template <typename local_index = size_t>
+class Mem_compact
+{
+	//! Starting point of each cell in cl_base
+	openfpm::vector<local_index> cl_start;
+
+	//! number of elements in each cell
+	openfpm::vector<local_index> cl_n;
+
+	//! base that store the data
+	typedef typename openfpm::vector<local_index> base;
+
+	//! elements of all the cells packed, (one element more to get a valid stop reference)
+	base cl_base;
+
+	//! Open cell, it is the last cell with a starting point, it can grow without
+	//! limits at the end of cl_base. The cells after it are empty. If equal to the number of cells
+	//! all the cells are closed (they cannot grow without reorganize the structure)
+	size_t tail;
+
+	/*! \brief Return the end of the used part of cl_base
+	 *
+	 * \return the end of the used part
+	 *
+	 */
+	inline size_t used() const
+	{
+		if (tail == cl_n.size())
+			return cl_start.get(tail);
+
+		return cl_start.get(tail) + cl_n.get(tail);
+	}
+
+	/*! \brief Reorganize the structure because a cell is full
+	 *
+	 * Each cell get the double of its elements plus MEM_COMPACT_MIN_SLACK as space
+	 *
+	 */
+	inline void realloc()
+	{
+		openfpm::vector<local_index> cl_start_(cl_start.size());
+		size_t n_cl = (tail == cl_n.size())?tail:tail+1;
+
+		// calculate the new size
+
+		size_t tot = 0;
+		for (size_t i = 0 ; i < n_cl ; i++)
+		{
+			cl_start_.get(i) = tot;
+			tot += 2*cl_n.get(i) + MEM_COMPACT_MIN_SLACK;
+		}
+
+		base cl_base_(tot + 1);
+
+		for (size_t i = 0 ; i < n_cl ; i++)
+		{
+			for (size_t j = 0 ; j < cl_n.get(i) ; j++)
+				cl_base_.get(cl_start_.get(i) + j) = cl_base.get(cl_start.get(i) + j);
+		}
+
+		// the cells after the open cell are empty, they start at the end of the used part
+
+		size_t end = (tail == cl_n.size())?tot:cl_start_.get(tail) + cl_n.get(tail);
+		for (size_t i = n_cl ; i < cl_start_.size() ; i++)
+			cl_start_.get(i) = end;
+
+		cl_start.swap(cl_start_);
+		cl_base.swap(cl_base_);
+	}
+
+public:
+
+	//! expose the type of the local index
+	typedef local_index loc_index;
+
+	/*! \brief return the number of cells
+	 *
+	 * \return the number of cells
+	 *
+	 */
+	inline size_t size()
+	{
+		return cl_n.size();
+	}
+
+	/*! \brief Initialize the data to zero
+	 *
+	 * \param slot unused
+	 * \param tot_n_cell total number of cells
+	 *
+	 */
+	inline void init_to_zero(local_index slot, local_index tot_n_cell)
+	{
+		cl_n.resize(tot_n_cell);
+		cl_n.fill(0);
+
+		cl_start.resize(tot_n_cell + 1);
+		cl_start.fill(0);
+
+		cl_base.resize(1);
+
+		tail = 0;
+	}
+
+	/*! \brief Initialize the data structure from the number of elements each cell will store
+	 *
+	 * The offsets are the exclusive prefix sum of the counters, each cell get exactly the
+	 * space for its elements
+	 *
+	 * \param cnt number of elements for each cell
+	 *
+	 */
+	inline void init_to_count(const openfpm::vector<local_index> & cnt)
+	{
+		cl_n.resize(cnt.size());
+		cl_n.fill(0);
+
+		cl_start.resize(cnt.size() + 1);
+
+		size_t tot = 0;
+		for (size_t i = 0 ; i < cnt.size() ; i++)
+		{
+			cl_start.get(i) = tot;
+			tot += cnt.get(i);
+		}
+		cl_start.get(cnt.size()) = tot;
+
+		cl_base.resize(tot + 1);
+
+		tail = cnt.size();
+	}
+
+	/*! \brief Set the number of elements in each cell
+	 *
+	 * It is used after init_to_count() when the elements has been written directly with get()
+	 * (for example by multiple threads at the same time)
+	 *
+	 * \param cnt number of elements for each cell
+	 *
+	 */
+	inline void set_n_elements(const openfpm::vector<local_index> & cnt)
+	{
+		cl_n = cnt;
+	}
+
+	/*! \brief copy an object Mem_compact
+	 *
+	 * \param mem Mem_compact to copy
+	 *
+	 */
+	inline void operator=(const Mem_compact<local_index> & mem)
+	{
+		cl_start = mem.cl_start;
+		cl_n = mem.cl_n;
+		cl_base = mem.cl_base;
+		tail = mem.tail;
+	}
+
+	/*! \brief copy an object Mem_compact
+	 *
+	 * \param mem Mem_compact to copy
+	 *
+	 */
+	inline void operator=(Mem_compact<local_index> && mem)
+	{
+		this->swap(mem);
+	}
+
+	/*! \brief Add an element to the cell
+	 *
+	 * \param cell_id id of the cell
+	 * \param ele element to add
+	 *
+	 */
+	inline void addCell(local_index cell_id, typename base::value_type ele)
+	{
+		if (cell_id < tail)
+		{
+			// closed cell, check that there is space
+
+			if (cl_n.get(cell_id) == cl_start.get(cell_id+1) - cl_start.get(cell_id))
+				realloc();
+		}
+		else if (cell_id > tail)
+		{
+			// close the open cell, the cells in between are empty
+
+			size_t end = used();
+
+			for (size_t i = tail + 1 ; i <= cell_id ; i++)
+				cl_start.get(i) = end;
+
+			tail = cell_id;
+		}
+
+		size_t id = cl_start.get(cell_id) + cl_n.get(cell_id);
+
+		if (cell_id == tail && id + 1 >= cl_base.size())
+			cl_base.resize(2*(id + 1));
+
+		cl_base.get(id) = ele;
+		cl_n.get(cell_id)++;
+	}
+
+	/*! \brief Add an element to the cell
+	 *
+	 * \param cell_id id of the cell
+	 * \param ele element to add
+	 *
+	 */
+	inline void add(local_index cell_id, typename base::value_type ele)
+	{
+		this->addCell(cell_id,ele);
+	}
+
+	/*! \brief Get an element in the cell
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id in the cell
+	 *
+	 * \return the reference to the selected element
+	 *
+	 */
+	inline auto get(local_index cell, local_index ele) -> decltype(cl_base.get(0)) &
+	{
+		return cl_base.get(cl_start.get(cell) + ele);
+	}
+
+	/*! \brief Get an element in the cell
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id in the cell
+	 *
+	 * \return the reference to the selected element
+	 *
+	 */
+	inline auto get(local_index cell, local_index ele) const -> decltype(cl_base.get(0)) &
+	{
+		return cl_base.get(cl_start.get(cell) + ele);
+	}
+
+	/*! \brief Remove an element in the cell
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id to remove
+	 *
+	 */
+	inline void remove(local_index cell, local_index ele)
+	{
+		size_t start = cl_start.get(cell);
+
+		for (size_t i = ele + 1 ; i < cl_n.get(cell) ; i++)
+			cl_base.get(start + i - 1) = cl_base.get(start + i);
+
+		cl_n.get(cell)--;
+	}
+
+	/*! \brief Get the number of elements in the cell
+	 *
+	 * \param cell_id id of the cell
+	 *
+	 * \return the number of elements in the cell
+	 *
+	 */
+	inline size_t getNelements(const local_index cell_id) const
+	{
+		return cl_n.get(cell_id);
+	}
+
+	/*! \brief swap to Mem_compact object
+	 *
+	 * \param mem object to swap the memory with
+	 *
+	 */
+	inline void swap(Mem_compact<local_index> & mem)
+	{
+		cl_start.swap(mem.cl_start);
+		cl_n.swap(mem.cl_n);
+		cl_base.swap(mem.cl_base);
+
+		size_t tail_tmp = mem.tail;
+		mem.tail = tail;
+		tail = tail_tmp;
+	}
+
+	/*! \brief swap to Mem_compact object
+	 *
+	 * \param mem object to swap the memory with
+	 *
+	 */
+	inline void swap(Mem_compact<local_index> && mem)
+	{
+		cl_start.swap(mem.cl_start);
+		cl_n.swap(mem.cl_n);
+		cl_base.swap(mem.cl_base);
+
+		size_t tail_tmp = mem.tail;
+		mem.tail = tail;
+		tail = tail_tmp;
+	}
+
+	/*! \brief Delete all the elements in the Cell-list
+	 *
+	 * The space of each cell is kept
+	 *
+	 */
+	inline void clear()
+	{
+		for (size_t i = 0 ; i < cl_n.size() ; i++)
+			cl_n.get(i) = 0;
+	}
+
+	/*! \brief Get the first element of a cell (as reference)
+	 *
+	 * \param cell_id cell-id
+	 *
+	 * \return a reference to the first element
+	 *
+	 */
+	inline const local_index & getStartId(local_index cell_id) const
+	{
+		return cl_base.get(cl_start.get(cell_id));
+	}
+
+	/*! \brief Get the last element of a cell (as reference)
+	 *
+	 * \param cell_id cell-id
+	 *
+	 * \return a reference to the last element
+	 *
+	 */
+	inline const local_index & getStopId(local_index cell_id) const
+	{
+		return cl_base.get(cl_start.get(cell_id) + cl_n.get(cell_id));
+	}
+
+	/*! \brief Just return the value pointed by part_id
+	 *
+	 * \param part_id
+	 *
+	 * \return the value pointed by part_id
+	 *
+	 */
+	inline const local_index & get_lin(const local_index * part_id) const
+	{
+		return *part_id;
+	}
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param slot unused
+	 *
+	 */
+	inline Mem_compact(local_index slot)
+	:tail(0)
+	{
+		cl_start.resize(1);
+		cl_start.get(0) = 0;
+		cl_base.resize(1);
+	}
+
+	/*! \brief Set the number of slot for each cell
+	 *
+	 * \param slot unused
+	 *
+	 */
+	inline void set_slot(local_index slot)
+	{}
+
+};
+
+
+#endif /* MEMCOMPACT_HPP_ */
@@ -99,6 +99,38 @@ public:
 		cl_base.resize(tot_n_cell * slot);
 	}
 
+	/*! \brief Initialize the data structure from the number of elements each cell will store
+	 *
+	 * The number of slots is set to the maximum count, so adding the counted
+	 * elements never trigger a realloc()
+	 *
+	 * \param cnt number of elements for each cell
+	 *
+	 */
+	inline void init_to_count(const openfpm::vector<local_index> & cnt)
+	{
+		local_index max_cnt = 0;
+
+		for (size_t i = 0 ; i < cnt.size() ; i++)
+			max_cnt = (cnt.get(i) > max_cnt)?cnt.get(i):max_cnt;
+
+		// addCell reallocate when nl + 1 >= slot
+		init_to_zero(max_cnt + 1,cnt.size());
+	}
+
+	/*! \brief Set the number of elements in each cell
+	 *
+	 * It is used after init_to_count() when the elements has been written directly with get()
+	 * (for example by multiple threads at the same time)
+	 *
+	 * \param cnt number of elements for each cell
+	 *
+	 */
+	inline void set_n_elements(const openfpm::vector<local_index> & cnt)
+	{
+		cl_n = cnt;
+	}
+
 	/*! \brief copy an object Mem_fast
 	 *
 	 * \param mem Mem_fast to copy
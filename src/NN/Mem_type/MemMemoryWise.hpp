@@ -61,6 +61,24 @@ public:
 		clear();
 	}
 
+	/*! \brief Initialize the data structure from the number of elements each cell will store
+	 *
+	 * Only the non empty cells are created, each one reserving the space for its elements
+	 *
+	 * \param cnt number of elements for each cell
+	 *
+	 */
+	inline void init_to_count(const openfpm::vector<local_index> & cnt)
+	{
+		clear();
+
+		for (size_t i = 0 ; i < cnt.size() ; i++)
+		{
+			if (cnt.get(i) != 0)
+				cl_base[i].reserve(cnt.get(i));
+		}
+	}
+
 	/*! \brief Copy two data-structure
 	 *
 	 * \param cell data-structure to copy
@@ -0,0 +1,515 @@
+/*
+ * MemSparse.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef MEMSPARSE_HPP_
+#define MEMSPARSE_HPP_
+
+#include "Vector/map_vector.hpp"
+#include <limits>
+
+/*! \brief Class for SPARSE cell list implementation
+ *
+ * Only the non-empty cells exist. They are stored in an open-addressing hash table
+ * (linear probing, power of two size, load factor at most 1/2) indexed by the cell-id,
+ * and the elements of all the cells are packed in a single array where each cell
+ * own a contiguous segment.
+ * The memory allocation is (in byte) Size = O(M_o*4*sizeof(local_index) + N*sizeof(ele))
+ *
+ * Where
+ *
+ * * N = total number of elements
+ * * M_o = number of non-empty cells
+ * * ele = element the structure is storing
+ *
+ * So the memory does not depend on the number of cells of the grid. It is useful for
+ * big domains where the particles occupy a small fraction of the cells (M >> M_o), where
+ * Mem_mw would use a dynamic vector for each cell.
+ *
+ * \note The structure is filled by the Cell-list with a sparse counting-sort (addCount()
+ *       for each element, init_from_count() and add), in this case the segments are packed
+ *       without holes. Adding in a cell that is full move the segment of the cell at the end
+ *       of the packed array with double space
+ *
+ */
+template <typename local_index = size_t>
+class Mem_sparse
+{
+	//! cell-id of each slot of the hash table (empty_key if the slot is empty)
+	openfpm::vector<local_index> t_key;
+
+	//! starting point in cl_base of the cell in each slot
+	openfpm::vector<local_index> t_start;
+
+	//! number of elements of the cell in each slot
+	openfpm::vector<local_index> t_n;
+
+	//! space reserved in cl_base for the cell in each slot
+	openfpm::vector<local_index> t_cap;
+
+	//! number of non-empty cells
+	size_t n_cell;
+
+	//! log2 of the hash table size
+	size_t t_bits;
+
+	//! base that store the data
+	typedef typename openfpm::vector<local_index> base;
+
+	//! elements of all the cells packed, (one element more to get a valid stop reference)
+	base cl_base;
+
+	//! In case of invalid element return this
+	local_index invalid;
+
+	//! Key that mark an empty slot
+	static const local_index empty_key = std::numeric_limits<local_index>::max();
+
+	/*! \brief hash of a cell-id (Fibonacci hashing)
+	 *
+	 * \param cell_id cell-id
+	 *
+	 * \return the first slot to check
+	 *
+	 */
+	inline size_t hash(local_index cell_id) const
+	{
+		return (size_t)(((unsigned long long)cell_id * 11400714819323198485ull) >> (64 - t_bits));
+	}
+
+	/*! \brief Find the slot of a cell
+	 *
+	 * \param cell_id cell-id
+	 *
+	 * \return the slot or -1 if the cell is empty
+	 *
+	 */
+	inline long int find(local_index cell_id) const
+	{
+		size_t mask = t_key.size() - 1;
+		size_t s = hash(cell_id);
+
+		while (t_key.get(s) != empty_key)
+		{
+			if (t_key.get(s) == cell_id)
+				return s;
+
+			s = (s + 1) & mask;
+		}
+
+		return -1;
+	}
+
+	/*! \brief Create the hash table of size 2^bits
+	 *
+	 * \param bits log2 of the size
+	 *
+	 */
+	inline void init_table(size_t bits)
+	{
+		t_bits = bits;
+
+		t_key.resize(1ul << bits);
+		t_start.resize(1ul << bits);
+		t_n.resize(1ul << bits);
+		t_cap.resize(1ul << bits);
+
+		for (size_t i = 0 ; i < t_key.size() ; i++)
+			t_key.get(i) = empty_key;
+
+		n_cell = 0;
+	}
+
+	/*! \brief Double the hash table
+	 *
+	 */
+	inline void rehash()
+	{
+		openfpm::vector<local_index> key_old;
+		openfpm::vector<local_index> start_old;
+		openfpm::vector<local_index> n_old;
+		openfpm::vector<local_index> cap_old;
+
+		key_old.swap(t_key);
+		start_old.swap(t_start);
+		n_old.swap(t_n);
+		cap_old.swap(t_cap);
+
+		init_table(t_bits + 1);
+
+		for (size_t i = 0 ; i < key_old.size() ; i++)
+		{
+			if (key_old.get(i) == empty_key)
+				continue;
+
+			size_t s = insert(key_old.get(i));
+			t_start.get(s) = start_old.get(i);
+			t_n.get(s) = n_old.get(i);
+			t_cap.get(s) = cap_old.get(i);
+		}
+	}
+
+	/*! \brief Find the slot of a cell, creating an empty cell if it does not exist
+	 *
+	 * \param cell_id cell-id
+	 *
+	 * \return the slot
+	 *
+	 */
+	inline size_t insert(local_index cell_id)
+	{
+		size_t mask = t_key.size() - 1;
+		size_t s = hash(cell_id);
+
+		while (t_key.get(s) != empty_key)
+		{
+			if (t_key.get(s) == cell_id)
+				return s;
+
+			s = (s + 1) & mask;
+		}
+
+		if (2*(n_cell + 1) > t_key.size())
+		{
+			rehash();
+			return insert(cell_id);
+		}
+
+		t_key.get(s) = cell_id;
+		t_start.get(s) = cl_base.size() - 1;
+		t_n.get(s) = 0;
+		t_cap.get(s) = 0;
+		n_cell++;
+
+		return s;
+	}
+
+	/*! \brief Move the segment of a full cell at the end of cl_base with double space
+	 *
+	 * \param s slot of the cell
+	 *
+	 */
+	inline void grow(size_t s)
+	{
+		size_t cap = (t_cap.get(s) == 0)?4:2*t_cap.get(s);
+		size_t start = cl_base.size() - 1;
+
+		cl_base.resize(start + cap + 1);
+
+		for (size_t i = 0 ; i < t_n.get(s) ; i++)
+			cl_base.get(start + i) = cl_base.get(t_start.get(s) + i);
+
+		t_start.get(s) = start;
+		t_cap.get(s) = cap;
+	}
+
+public:
+
+	//! expose the type of the local index
+	typedef local_index loc_index;
+
+	/*! \brief return the number of non-empty cells
+	 *
+	 * \return the number of non-empty cells
+	 *
+	 */
+	inline size_t size() const
+	{
+		return n_cell;
+	}
+
+	/*! \brief Initialize the data to zero
+	 *
+	 * \param slot unused
+	 * \param tot_n_cell total number of cells (unused)
+	 *
+	 */
+	inline void init_to_zero(local_index slot, local_index tot_n_cell)
+	{
+		clear();
+	}
+
+	/*! \brief Initialize the data structure from the number of elements each cell will store
+	 *
+	 * Only the non empty cells are created
+	 *
+	 * \param cnt number of elements for each cell
+	 *
+	 */
+	inline void init_to_count(const openfpm::vector<local_index> & cnt)
+	{
+		clear();
+
+		for (size_t i = 0 ; i < cnt.size() ; i++)
+		{
+			for (size_t j = 0 ; j < cnt.get(i) ; j++)
+				addCount(i);
+		}
+
+		init_from_count();
+	}
+
+	/*! \brief Count one element more in a cell
+	 *
+	 * It is the first pass of the sparse counting-sort construction, when all the elements
+	 * has been counted init_from_count() give to each cell exactly the space for its elements
+	 *
+	 * \param cell_id cell-id
+	 *
+	 */
+	inline void addCount(local_index cell_id)
+	{
+		t_n.get(insert(cell_id))++;
+	}
+
+	/*! \brief Pack the cells from the counters set with addCount()
+	 *
+	 * The cells remain with zero elements and exactly the space counted
+	 *
+	 */
+	inline void init_from_count()
+	{
+		size_t tot = 0;
+
+		for (size_t s = 0 ; s < t_key.size() ; s++)
+		{
+			if (t_key.get(s) == empty_key)
+				continue;
+
+			t_start.get(s) = tot;
+			t_cap.get(s) = t_n.get(s);
+			tot += t_n.get(s);
+			t_n.get(s) = 0;
+		}
+
+		cl_base.resize(tot + 1);
+	}
+
+	/*! \brief copy an object Mem_sparse
+	 *
+	 * \param mem Mem_sparse to copy
+	 *
+	 */
+	inline void operator=(const Mem_sparse<local_index> & mem)
+	{
+		t_key = mem.t_key;
+		t_start = mem.t_start;
+		t_n = mem.t_n;
+		t_cap = mem.t_cap;
+		n_cell = mem.n_cell;
+		t_bits = mem.t_bits;
+		cl_base = mem.cl_base;
+	}
+
+	/*! \brief Add an element to the cell
+	 *
+	 * \param cell_id id of the cell
+	 * \param ele element to add
+	 *
+	 */
+	inline void addCell(local_index cell_id, typename base::value_type ele)
+	{
+		size_t s = insert(cell_id);
+
+		if (t_n.get(s) == t_cap.get(s))
+			grow(s);
+
+		cl_base.get(t_start.get(s) + t_n.get(s)) = ele;
+		t_n.get(s)++;
+	}
+
+	/*! \brief Add an element to the cell
+	 *
+	 * \param cell_id id of the cell
+	 * \param ele element to add
+	 *
+	 */
+	inline void add(local_index cell_id, typename base::value_type ele)
+	{
+		this->addCell(cell_id,ele);
+	}
+
+	/*! \brief Get an element in the cell
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id in the cell
+	 *
+	 * \return the reference to the selected element
+	 *
+	 */
+	inline local_index & get(local_index cell, local_index ele)
+	{
+		long int s = find(cell);
+		if (s == -1)
+			return invalid;
+
+		return cl_base.get(t_start.get(s) + ele);
+	}
+
+	/*! \brief Get an element in the cell
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id in the cell
+	 *
+	 * \return the reference to the selected element
+	 *
+	 */
+	inline const local_index & get(local_index cell, local_index ele) const
+	{
+		long int s = find(cell);
+		if (s == -1)
+			return invalid;
+
+		return cl_base.get(t_start.get(s) + ele);
+	}
+
+	/*! \brief Remove an element in the cell
+	 *
+	 * \param cell id of the cell
+	 * \param ele element id to remove
+	 *
+	 */
+	inline void remove(local_index cell, local_index ele)
+	{
+		long int s = find(cell);
+		if (s == -1)
+			return;
+
+		size_t start = t_start.get(s);
+
+		for (size_t i = ele + 1 ; i < t_n.get(s) ; i++)
+			cl_base.get(start + i - 1) = cl_base.get(start + i);
+
+		t_n.get(s)--;
+	}
+
+	/*! \brief Get the number of elements in the cell
+	 *
+	 * \param cell_id id of the cell
+	 *
+	 * \return the number of elements in the cell
+	 *
+	 */
+	inline size_t getNelements(const local_index cell_id) const
+	{
+		long int s = find(cell_id);
+		if (s == -1)
+			return 0;
+
+		return t_n.get(s);
+	}
+
+	/*! \brief swap to Mem_sparse object
+	 *
+	 * \param mem object to swap the memory with
+	 *
+	 */
+	inline void swap(Mem_sparse<local_index> & mem)
+	{
+		t_key.swap(mem.t_key);
+		t_start.swap(mem.t_start);
+		t_n.swap(mem.t_n);
+		t_cap.swap(mem.t_cap);
+		cl_base.swap(mem.cl_base);
+
+		size_t n_cell_tmp = mem.n_cell;
+		mem.n_cell = n_cell;
+		n_cell = n_cell_tmp;
+
+		size_t t_bits_tmp = mem.t_bits;
+		mem.t_bits = t_bits;
+		t_bits = t_bits_tmp;
+	}
+
+	/*! \brief swap to Mem_sparse object
+	 *
+	 * \param mem object to swap the memory with
+	 *
+	 */
+	inline void swap(Mem_sparse<local_index> && mem)
+	{
+		swap(mem);
+	}
+
+	/*! \brief Delete all the elements and all the cells
+	 *
+	 */
+	inline void clear()
+	{
+		init_table(4);
+		cl_base.resize(1);
+	}
+
+	/*! \brief Get the first element of a cell (as reference)
+	 *
+	 * \param cell_id cell-id
+	 *
+	 * \return a reference to the first element
+	 *
+	 */
+	inline const local_index & getStartId(local_index cell_id) const
+	{
+		long int s = find(cell_id);
+		if (s == -1)
+			return invalid;
+
+		return cl_base.get(t_start.get(s));
+	}
+
+	/*! \brief Get the last element of a cell (as reference)
+	 *
+	 * \param cell_id cell-id
+	 *
+	 * \return a reference to the last element
+	 *
+	 */
+	inline const local_index & getStopId(local_index cell_id) const
+	{
+		long int s = find(cell_id);
+		if (s == -1)
+			return invalid;
+
+		return cl_base.get(t_start.get(s) + t_n.get(s));
+	}
+
+	/*! \brief Just return the value pointed by part_id
+	 *
+	 * \param part_id
+	 *
+	 * \return the value pointed by part_id
+	 *
+	 */
+	inline const local_index & get_lin(const local_index * part_id) const
+	{
+		return *part_id;
+	}
+
+public:
+
+	/*! \brief Constructor
+	 *
+	 * \param slot unused
+	 *
+	 */
+	inline Mem_sparse(local_index slot)
+	:invalid(0)
+	{
+		clear();
+	}
+
+	/*! \brief Set the number of slot for each cell
+	 *
+	 * \param slot unused
+	 *
+	 */
+	inline void set_slot(local_index slot)
+	{}
+
+};
+
+template <typename local_index> const local_index Mem_sparse<local_index>::empty_key;
+
+#endif /* MEMSPARSE_HPP_ */
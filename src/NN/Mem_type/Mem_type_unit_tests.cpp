@@ -10,6 +10,8 @@
 #include "NN/Mem_type/MemFast.hpp"
 #include "NN/Mem_type/MemBalanced.hpp"
 #include "NN/Mem_type/MemMemoryWise.hpp"
+#include "NN/Mem_type/MemCompact.hpp"
+#include "NN/Mem_type/MemSparse.hpp"
 
 BOOST_AUTO_TEST_SUITE( Mem_type_test )
 
@@ -33,11 +35,89 @@ void test_mem_type()
 	BOOST_REQUIRE_EQUAL(mem.getNelements(0),0ul);
 }
 
+template<typename Mem_type>
+void test_mem_type_out_of_order()
+{
+	Mem_type mem(16);
+
+	mem.init_to_zero(16,10);
+
+	// add in the cells in non increasing order
+
+	for (size_t i = 0 ; i < 100 ; i++)
+		mem.add((7*i) % 10,i);
+
+	for (size_t c = 0 ; c < 10 ; c++)
+	{
+		BOOST_REQUIRE_EQUAL(mem.getNelements(c),10ul);
+
+		size_t k = 0;
+		for (size_t i = 0 ; i < 100 ; i++)
+		{
+			if ((7*i) % 10 != c)	continue;
+
+			BOOST_REQUIRE_EQUAL(mem.get(c,k),i);
+			k++;
+		}
+	}
+}
+
 BOOST_AUTO_TEST_CASE ( Mem_type_check )
 {
 	test_mem_type<Mem_fast<>>();
 	test_mem_type<Mem_bal<>>();
 	test_mem_type<Mem_mw<>>();
+	test_mem_type<Mem_compact<>>();
+	test_mem_type<Mem_sparse<>>();
+
+	test_mem_type_out_of_order<Mem_fast<>>();
+	test_mem_type_out_of_order<Mem_bal<>>();
+	test_mem_type_out_of_order<Mem_mw<>>();
+	test_mem_type_out_of_order<Mem_compact<>>();
+	test_mem_type_out_of_order<Mem_sparse<>>();
+}
+
+BOOST_AUTO_TEST_CASE ( Mem_type_sparse )
+{
+	Mem_sparse<> mem(16);
+
+	// 10^12 cells, only 1000 used
+
+	mem.init_to_zero(16,1000000000000ul);
+
+	for (size_t i = 0 ; i < 3000 ; i++)
+		mem.addCount((i % 1000) * 1000000007ul);
+
+	mem.init_from_count();
+
+	for (size_t i = 0 ; i < 3000 ; i++)
+		mem.add((i % 1000) * 1000000007ul,i);
+
+	BOOST_REQUIRE_EQUAL(mem.size(),1000ul);
+
+	for (size_t c = 0 ; c < 1000 ; c++)
+	{
+		size_t cell = c * 1000000007ul;
+
+		BOOST_REQUIRE_EQUAL(mem.getNelements(cell),3ul);
+		BOOST_REQUIRE_EQUAL(&mem.getStopId(cell) - &mem.getStartId(cell),3);
+
+		for (size_t k = 0 ; k < 3 ; k++)
+			BOOST_REQUIRE_EQUAL(mem.get(cell,k),c + 1000*k);
+	}
+
+	// empty cells
+
+	BOOST_REQUIRE_EQUAL(mem.getNelements(1),0ul);
+	BOOST_REQUIRE(&mem.getStartId(1) == &mem.getStopId(1));
+
+	// adding to a full cell move it
+
+	mem.add(0,5000);
+	BOOST_REQUIRE_EQUAL(mem.getNelements(0),4ul);
+	BOOST_REQUIRE_EQUAL(mem.get(0,0),0ul);
+	BOOST_REQUIRE_EQUAL(mem.get(0,3),5000ul);
+	BOOST_REQUIRE_EQUAL(mem.get(1000000007ul,0),1ul);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
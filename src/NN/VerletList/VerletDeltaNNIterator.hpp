@@ -0,0 +1,99 @@
+/*
+ * VerletDeltaNNIterator.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETDELTANNITERATOR_HPP_
+#define OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETDELTANNITERATOR_HPP_
+
+#include <cstring>
+#include <limits>
+
+/*! \brief Iterator for the neighborhood of a delta-encoded Verlet-list
+ *
+ * In general you never create it directly but you get it from VerletListDelta
+ *
+ * Each neighborhood is stored as the difference from the particle id. If the difference
+ * does not fit delta_type the escape value (the minimum of delta_type) is followed by the
+ * full id written in the next VerletListDelta::n_raw elements
+ *
+ * \tparam delta_type type of the stored difference (int8_t, int16_t, int32_t)
+ * \tparam local_index type of the particle id
+ *
+ */
+template<typename delta_type, typename local_index>
+class VerletDeltaNNIterator
+{
+	//! actual neighborhood
+	const delta_type * ele;
+
+	//! stop of the neighborhood
+	const delta_type * stop;
+
+	//! particle id
+	long int part_id;
+
+public:
+
+	//! escape value
+	static const delta_type escape = std::numeric_limits<delta_type>::min();
+
+	//! number of delta_type used to store a full id
+	static const size_t n_raw = (sizeof(local_index) + sizeof(delta_type) - 1) / sizeof(delta_type);
+
+	/*! \brief Constructor
+	 *
+	 * \param part_id Particle id
+	 * \param start first element of the neighborhood
+	 * \param stop end of the neighborhood
+	 *
+	 */
+	inline VerletDeltaNNIterator(size_t part_id, const delta_type * start, const delta_type * stop)
+	:ele(start),stop(stop),part_id(part_id)
+	{}
+
+	/*! \brief Check if there is the next element
+	 *
+	 * \return true if there is the next element
+	 *
+	 */
+	inline bool isNext()
+	{
+		return ele < stop;
+	}
+
+	/*! \brief take the next element
+	 *
+	 * \return itself
+	 *
+	 */
+	inline VerletDeltaNNIterator & operator++()
+	{
+		ele += (*ele == escape)?1+n_raw:1;
+
+		return *this;
+	}
+
+	/*! \brief Get the neighborhood id
+	 *
+	 * \return the neighborhood id
+	 *
+	 */
+	inline local_index get()
+	{
+		if (*ele != escape)
+			return part_id + *ele;
+
+		local_index id;
+		std::memcpy(&id,ele+1,sizeof(local_index));
+
+		return id;
+	}
+};
+
+template<typename delta_type, typename local_index> const delta_type VerletDeltaNNIterator<delta_type,local_index>::escape;
+template<typename delta_type, typename local_index> const size_t VerletDeltaNNIterator<delta_type,local_index>::n_raw;
+
+#endif /* OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETDELTANNITERATOR_HPP_ */
@@ -0,0 +1,180 @@
+/*
+ * VerletDistFilter.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETDISTFILTER_HPP_
+#define OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETDISTFILTER_HPP_
+
+#include "Vector/map_vector.hpp"
+#include "Space/Shape/Point.hpp"
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+/*! \brief Filter the candidate neighborhood of a particle by distance
+ *
+ * The candidates produced by a Cell-list neighborhood iterator are gathered together
+ * with their positions in a Structure of Arrays buffer (one array for each coordinate).
+ * The distances are calculated in a loop without branches that the compiler vectorize
+ * and the ids that survive the filter are compacted at the beginning of the id buffer
+ * (in the original order)
+ *
+ * \tparam dim dimensionality
+ * \tparam T type of space
+ * \tparam id_type type of the particle id
+ *
+ */
+template<unsigned int dim, typename T, typename id_type>
+class VerletDistFilter
+{
+	//! candidates id
+	openfpm::vector<id_type> ids;
+
+	//! coordinates of the candidates
+	openfpm::vector<T> xq[dim];
+
+	//! square distances of the candidates
+	openfpm::vector<T> d2;
+
+	/*! \brief Compact the ids that are in the cut-off radius (portable implementation)
+	 *
+	 * \param r_cut2 square of the cut-off radius
+	 *
+	 * \return the number of the surviving ids
+	 *
+	 */
+	template<typename Tp> inline size_t compact(T r_cut2, Tp)
+	{
+		id_type * id = &ids.get(0);
+		const T * d = &d2.get(0);
+
+		size_t n = 0;
+
+		for (size_t k = 0 ; k < ids.size() ; k++)
+		{
+			id[n] = id[k];
+			n += (d[k] < r_cut2);
+		}
+
+		return n;
+	}
+
+#if defined(__AVX512F__)
+
+	/*! \brief Compact the ids that are in the cut-off radius (AVX-512 mask-compress)
+	 *
+	 * \param r_cut2 square of the cut-off radius
+	 *
+	 * \return the number of the surviving ids
+	 *
+	 */
+	inline size_t compact(T r_cut2, std::true_type)
+	{
+		id_type * id = &ids.get(0);
+		const double * d = &d2.get(0);
+
+		__m512d rc2 = _mm512_set1_pd(r_cut2);
+
+		size_t n = 0;
+		size_t k = 0;
+
+		for ( ; k + 8 <= ids.size() ; k += 8)
+		{
+			__mmask8 m = _mm512_cmp_pd_mask(_mm512_loadu_pd(d + k),rc2,_CMP_LT_OQ);
+			__m512i v = _mm512_loadu_si512((const void *)(id + k));
+
+			_mm512_mask_compressstoreu_epi64((void *)(id + n),m,v);
+			n += __builtin_popcount(m);
+		}
+
+		for ( ; k < ids.size() ; k++)
+		{
+			id[n] = id[k];
+			n += (d[k] < r_cut2);
+		}
+
+		return n;
+	}
+
+#endif
+
+public:
+
+	/*! \brief Remove all the candidates
+	 *
+	 */
+	inline void clear()
+	{
+		ids.clear();
+
+		for (size_t j = 0 ; j < dim ; j++)
+			xq[j].clear();
+	}
+
+	/*! \brief Add a candidate
+	 *
+	 * \param id id of the candidate
+	 * \param pos vector of the particle positions
+	 *
+	 */
+	inline void add(id_type id, const openfpm::vector<Point<dim,T>> & pos)
+	{
+		ids.add(id);
+
+		for (size_t j = 0 ; j < dim ; j++)
+			xq[j].add(pos.template get<0>(id)[j]);
+	}
+
+	/*! \brief Keep only the candidates that are in the cut-off radius
+	 *
+	 * \param xp position of the particle
+	 * \param r_cut2 square of the cut-off radius
+	 *
+	 * \return the number of neighborhood in the cut-off radius, they can be read with get()
+	 *
+	 */
+	inline size_t filter(const Point<dim,T> & xp, T r_cut2)
+	{
+		size_t n_c = ids.size();
+
+		if (n_c == 0)
+			return 0;
+
+		d2.resize(n_c);
+		T * d = &d2.get(0);
+
+		for (size_t k = 0 ; k < n_c ; k++)
+			d[k] = 0.0;
+
+		for (size_t j = 0 ; j < dim ; j++)
+		{
+			const T * x = &xq[j].get(0);
+			T c = xp.get(j);
+
+			for (size_t k = 0 ; k < n_c ; k++)
+			{
+				T dx = x[k] - c;
+				d[k] += dx*dx;
+			}
+		}
+
+		return compact(r_cut2,std::integral_constant<bool,std::is_same<T,double>::value && sizeof(id_type) == 8>());
+	}
+
+	/*! \brief Get the neighborhood k surviving the filter
+	 *
+	 * \param k neighborhood
+	 *
+	 * \return the id of the neighborhood
+	 *
+	 */
+	inline id_type get(size_t k) const
+	{
+		return ids.get(k);
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETDISTFILTER_HPP_ */
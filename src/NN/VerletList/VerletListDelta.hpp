@@ -0,0 +1,157 @@
+/*
+ * VerletListDelta.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETLISTDELTA_HPP_
+#define OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETLISTDELTA_HPP_
+
+#include "Vector/map_vector.hpp"
+#include "VerletDeltaNNIterator.hpp"
+
+/*! \brief Compressed (read-only) copy of a Verlet-list
+ *
+ * The neighborhood of the particle p are stored as the differences q - p in delta_type.
+ * After reordering the particles along a space filling curve (see reorder_sfc) the
+ * neighborhood ids are close to the particle id, so with int16_t the memory read by a
+ * force loop is 1/4 of a Verlet-list of size_t. Differences that does not fit are
+ * stored with an escape value followed by the full id.
+ *
+ * The iteration order is the same of the original Verlet-list
+ *
+ * \snippet VerletList_test.hpp Usage of VerletListDelta
+ *
+ * \tparam delta_type type of the stored difference (int8_t, int16_t, int32_t)
+ * \tparam local_index type of the particle id
+ *
+ */
+template<typename delta_type = short int, typename local_index = size_t>
+class VerletListDelta
+{
+	//! Iterator type
+	typedef VerletDeltaNNIterator<delta_type,local_index> NN_it;
+
+	static_assert(std::is_signed<delta_type>::value == true,"delta_type must be a signed type");
+
+	//! start of the neighborhood of each particle in nn (one element more for the stop)
+	openfpm::vector<local_index> start;
+
+	//! number of neighborhood of each particle
+	openfpm::vector<local_index> n_nn;
+
+	//! encoded neighborhood
+	openfpm::vector<delta_type> nn;
+
+	/*! \brief Encode one neighborhood
+	 *
+	 * \param p particle
+	 * \param q neighborhood
+	 *
+	 */
+	inline void encode(long int p, local_index q)
+	{
+		long int d = (long int)q - p;
+
+		if (d > std::numeric_limits<delta_type>::min() && d <= std::numeric_limits<delta_type>::max())
+		{
+			nn.add((delta_type)d);
+			return;
+		}
+
+		delta_type raw[NN_it::n_raw] = {};
+		std::memcpy(raw,&q,sizeof(local_index));
+
+		nn.add(NN_it::escape);
+		for (size_t k = 0 ; k < NN_it::n_raw ; k++)
+			nn.add(raw[k]);
+	}
+
+public:
+
+	/*! \brief Compress a Verlet-list
+	 *
+	 * \param ver Verlet-list to compress
+	 *
+	 */
+	template<typename Verlet_type> void compress(Verlet_type & ver)
+	{
+		size_t n_part = ver.size();
+
+		start.resize(n_part + 1);
+		n_nn.resize(n_part);
+		nn.clear();
+
+		for (size_t p = 0 ; p < n_part ; p++)
+		{
+			start.get(p) = nn.size();
+			n_nn.get(p) = ver.getNNPart(p);
+
+			for (size_t j = 0 ; j < n_nn.get(p) ; j++)
+				encode(p,ver.get(p,j));
+		}
+
+		start.get(n_part) = nn.size();
+	}
+
+	/*! \brief Return the number of particles
+	 *
+	 * \return the number of particles
+	 *
+	 */
+	inline size_t size() const
+	{
+		return n_nn.size();
+	}
+
+	/*! \brief Return the number of neighborhood particles for the particle id
+	 *
+	 * \param part_id id of the particle
+	 *
+	 * \return number of neighborhood particles for a particular particle id
+	 *
+	 */
+	inline size_t getNNPart(size_t part_id) const
+	{
+		return n_nn.get(part_id);
+	}
+
+	/*! \brief Return the number of delta_type elements used to store all the neighborhood
+	 *
+	 * \return the number of encoded elements
+	 *
+	 */
+	inline size_t getNEncoded() const
+	{
+		return nn.size();
+	}
+
+	/*! \brief Get the Neighborhood iterator
+	 *
+	 * It iterate across all the neighborhood particles of a selected particle
+	 *
+	 * \param part_id particle id
+	 *
+	 * \return an iterator across the neighborhood particles
+	 *
+	 */
+	inline NN_it getNNIterator(size_t part_id) const
+	{
+		const delta_type * base = (nn.size() == 0)?NULL:&nn.get(0);
+
+		return NN_it(part_id,base + start.get(part_id),base + start.get(part_id+1));
+	}
+
+	/*! \brief Clear the Verlet-list
+	 *
+	 */
+	void clear()
+	{
+		start.clear();
+		n_nn.clear();
+		nn.clear();
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETLISTDELTA_HPP_ */
@@ -13,6 +13,11 @@
 #include "NN/Mem_type/MemFast.hpp"
 #include "NN/Mem_type/MemBalanced.hpp"
 #include "NN/Mem_type/MemMemoryWise.hpp"
+#include "NN/Mem_type/MemCompact.hpp"
+#include "VerletDistFilter.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #define VERLET_STARTING_NSLOT 128
 
@@ -295,6 +300,81 @@ private:
 	//! Interlal cell-list
 	CellListImpl cli;
 
+	//! Per-thread buffer of neighborhood (multi-threaded construction)
+	openfpm::vector<openfpm::vector<typename Mem_type::loc_index>> thr_nn;
+
+	//! Per-thread number of neighborhood of each processed particle (multi-threaded construction)
+	openfpm::vector<openfpm::vector<typename Mem_type::loc_index>> thr_nn_cnt;
+
+	//! Per-thread processed particles (multi-threaded construction)
+	openfpm::vector<openfpm::vector<typename Mem_type::loc_index>> thr_part;
+
+	//! Number of neighborhood of each particle (multi-threaded construction)
+	openfpm::vector<typename Mem_type::loc_index> nn_cnt;
+
+	//! skin, the Verlet-list is constructed with r_cut + skin
+	T skin;
+
+	//! Position of the particles at the last construction (used only with skin)
+	openfpm::vector<Point<dim,T>> pos_last;
+
+	//! ghost marker at the last construction
+	size_t g_m_last;
+
+	//! Indicate if the last update reconstructed the Verlet-list
+	bool rebuilt;
+
+	//! Maximum number of threads used by the construction (1 = serial construction)
+	size_t n_thr;
+
+	/*! \brief Check if the Verlet-list must be reconstructed
+	 *
+	 * It must be reconstructed if one particle moved more than skin/2 from the last construction,
+	 * or if the number of particles changed. Without skin it must be always reconstructed
+	 *
+	 * \param pos vector of particle positions
+	 * \param g_m ghost marker
+	 *
+	 * \return true if the Verlet-list must be reconstructed
+	 *
+	 */
+	bool needRebuild(const openfpm::vector<Point<dim,T>> & pos, size_t g_m)
+	{
+		if (skin == 0.0 || pos.size() != pos_last.size() || g_m != g_m_last)
+			return true;
+
+		// maximum allowed square displacement
+		T lim2 = skin * skin / 4.0;
+
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{
+			Point<dim,T> p = pos.template get<0>(i);
+			Point<dim,T> pl = pos_last.template get<0>(i);
+
+			if (p.distance2(pl) > lim2)
+				return true;
+		}
+
+		return false;
+	}
+
+	/*! \brief Save the position of the particles used to construct the Verlet-list
+	 *
+	 * \param pos vector of particle positions
+	 * \param g_m ghost marker
+	 *
+	 */
+	void saveRef(const openfpm::vector<Point<dim,T>> & pos, size_t g_m)
+	{
+		rebuilt = true;
+
+		if (skin == 0.0)
+			return;
+
+		pos_last = pos;
+		g_m_last = g_m;
+	}
+
 
 	/*! \brief Fill the cell-list with data
 	 *
@@ -353,8 +433,10 @@ private:
 	 * \param anom list of domain cells with non-normal neighborhood
 	 * \param opt options
 	 *
+	 * Serial implementation, the neighborhood are added particle by particle
+	 *
 	 */
-	template<typename NN_type, int type> inline void create_(const openfpm::vector<Point<dim,T>> & pos, const openfpm::vector<Point<dim,T>> & pos2 , const openfpm::vector<size_t> & dom, const openfpm::vector<subsub_lin<dim>> & anom, T r_cut, size_t g_m, CellListImpl & cli, size_t opt)
+	template<typename NN_type, int type> inline void create_impl(const openfpm::vector<Point<dim,T>> & pos, const openfpm::vector<Point<dim,T>> & pos2 , const openfpm::vector<size_t> & dom, const openfpm::vector<subsub_lin<dim>> & anom, T r_cut, size_t g_m, CellListImpl & cli, size_t opt, std::false_type)
 	{
 		size_t end;
 
@@ -367,6 +449,8 @@ private:
 		// square of the cutting radius
 		T r_cut2 = r_cut * r_cut;
 
+		VerletDistFilter<dim,T,typename Mem_type::loc_index> flt;
+
 		// iterate the particles
 		while (it.isNext())
 		{
@@ -377,23 +461,216 @@ private:
 			NN_type NN = NNType<dim,T,CellListImpl,decltype(it),type,typename Mem_type::loc_index>::get(it,pos,xp,i,cli,r_cut);
 			NNType<dim,T,CellListImpl,decltype(it),type,typename Mem_type::loc_index>::add(i,dp);
 
+			// gather the candidates
+			flt.clear();
+
 			while (NN.isNext())
 			{
-				auto nnp = NN.get();
-
-				Point<dim,T> xq = pos2.template get<0>(nnp);
-
-				if (xp.distance2(xq) < r_cut2)
-					addPart(i,nnp);
+				flt.add(NN.get(),pos2);
 
 				// Next particle
 				++NN;
 			}
 
+			size_t n_nn = flt.filter(xp,r_cut2);
+
+			for (size_t k = 0 ; k < n_nn ; k++)
+				addPart(i,flt.get(k));
+
 			++it;
 		}
 	}
 
+	/*! \brief Create the Verlet list from a given cell-list
+	 *
+	 * \param pos vector of positions
+	 * \param pos2 vector of position for the neighborhood
+	 * \param r_cut cut-off radius to get the neighborhood particles
+	 * \param g_m Indicate form which particles to construct the verlet list
+	 * \param cli Cell-list elements to use to construct the verlet list
+	 * \param dom list of domain cells with normal neighborhood
+	 * \param anom list of domain cells with non-normal neighborhood
+	 * \param opt options
+	 *
+	 * Multi-threaded implementation. The particle sequence of the particle iterator (for CRS it
+	 * follow the cells order) is divided in contiguous chunks, one for each thread. Every
+	 * thread calculate the neighborhood of its chunk in a private buffer, the buffers are
+	 * stitched together in the final structure after one prefix sum over the number of
+	 * neighborhood of each particle (done by Mem_type::init_to_count)
+	 *
+	 */
+	template<typename NN_type, int type> inline void create_impl(const openfpm::vector<Point<dim,T>> & pos, const openfpm::vector<Point<dim,T>> & pos2 , const openfpm::vector<size_t> & dom, const openfpm::vector<subsub_lin<dim>> & anom, T r_cut, size_t g_m, CellListImpl & cli, size_t opt, std::true_type)
+	{
+#ifdef _OPENMP
+
+		size_t n_thr = this->n_thr;
+
+		if (n_thr <= 1)
+		{
+			create_impl<NN_type,type>(pos,pos2,dom,anom,r_cut,g_m,cli,opt,std::false_type());
+			return;
+		}
+
+		size_t end;
+
+		auto it = PartItNN<type,dim,openfpm::vector<Point<dim,T>>,CellListImpl>::get(pos,dom,anom,cli,g_m,end);
+
+		typedef NNType<dim,T,CellListImpl,decltype(it),type,typename Mem_type::loc_index> NNT;
+
+		// First walk, count the particles and create the domain particle sequence
+
+		dp.clear();
+		size_t n_part = 0;
+
+		while (it.isNext())
+		{
+			NNT::add(it.get(),dp);
+			n_part++;
+			++it;
+		}
+
+		// Second walk, get the starting point of the chunk of each thread
+
+		n_thr = (n_thr > n_part)?n_part:n_thr;
+
+		openfpm::vector<decltype(it)> chunk;
+
+		auto it2 = PartItNN<type,dim,openfpm::vector<Point<dim,T>>,CellListImpl>::get(pos,dom,anom,cli,g_m,end);
+
+		for (size_t k = 0 ; k < n_part ; k++)
+		{
+			if (chunk.size() < n_thr && k == n_part * chunk.size() / n_thr)
+				chunk.add(it2);
+
+			++it2;
+		}
+
+		thr_nn.resize(n_thr);
+		thr_nn_cnt.resize(n_thr);
+		thr_part.resize(n_thr);
+
+		nn_cnt.resize(end);
+		nn_cnt.fill(0);
+
+		// square of the cutting radius
+		T r_cut2 = r_cut * r_cut;
+
+		// The work is split in n_thr chunks distributed across the threads of the team,
+		// the runtime can give less threads than requested, so a thread can process
+		// more than one chunk
+
+		#pragma omp parallel num_threads(n_thr)
+		{
+			VerletDistFilter<dim,T,typename Mem_type::loc_index> flt;
+
+			#pragma omp for schedule(static,1)
+			for (size_t t = 0 ; t < n_thr ; t++)
+			{
+				size_t start = n_part * t / n_thr;
+				size_t stop = n_part * (t+1) / n_thr;
+
+				openfpm::vector<typename Mem_type::loc_index> & nn = thr_nn.get(t);
+				openfpm::vector<typename Mem_type::loc_index> & cnt = thr_nn_cnt.get(t);
+				openfpm::vector<typename Mem_type::loc_index> & part = thr_part.get(t);
+
+				nn.clear();
+				cnt.clear();
+				part.clear();
+
+				auto itc = chunk.get(t);
+
+				// calculate the neighborhood of the chunk
+
+				for (size_t p = start ; p < stop ; p++)
+				{
+					typename Mem_type::loc_index i = itc.get();
+					Point<dim,T> xp = pos.template get<0>(i);
+
+					NN_type NN = NNT::get(itc,pos,xp,i,cli,r_cut);
+
+					// gather the candidates
+					flt.clear();
+
+					while (NN.isNext())
+					{
+						flt.add(NN.get(),pos2);
+
+						// Next particle
+						++NN;
+					}
+
+					size_t n_nn = flt.filter(xp,r_cut2);
+
+					for (size_t k = 0 ; k < n_nn ; k++)
+						nn.add(flt.get(k));
+
+					part.add(i);
+					cnt.add(n_nn);
+					nn_cnt.get(i) = n_nn;
+
+					++itc;
+				}
+			}
+
+			#pragma omp single
+			Mem_type::init_to_count(nn_cnt);
+
+			// stitch the buffers into the final structure
+
+			#pragma omp for schedule(static,1)
+			for (size_t t = 0 ; t < n_thr ; t++)
+			{
+				openfpm::vector<typename Mem_type::loc_index> & nn = thr_nn.get(t);
+				openfpm::vector<typename Mem_type::loc_index> & cnt = thr_nn_cnt.get(t);
+				openfpm::vector<typename Mem_type::loc_index> & part = thr_part.get(t);
+
+				size_t id = 0;
+
+				for (size_t k = 0 ; k < part.size() ; k++)
+				{
+					typename Mem_type::loc_index i = part.get(k);
+
+					for (size_t j = 0 ; j < cnt.get(k) ; j++)
+					{
+						Mem_type::get(i,j) = nn.get(id);
+						id++;
+					}
+				}
+			}
+		}
+
+		Mem_type::set_n_elements(nn_cnt);
+
+#else
+
+		create_impl<NN_type,type>(pos,pos2,dom,anom,r_cut,g_m,cli,opt,std::false_type());
+
+#endif
+	}
+
+	/*! \brief Create the Verlet list from a given cell-list
+	 *
+	 * \param pos vector of positions
+	 * \param pos2 vector of position for the neighborhood
+	 * \param r_cut cut-off radius to get the neighborhood particles
+	 * \param g_m Indicate form which particles to construct the verlet list. For example
+	 * 			if we have 120 particles and g_m = 100, the Verlet list will be constructed only for the first
+	 * 			100 particles
+	 * \param cli Cell-list elements to use to construct the verlet list
+	 * \param dom list of domain cells with normal neighborhood
+	 * \param anom list of domain cells with non-normal neighborhood
+	 * \param opt options
+	 *
+	 * \note When the Mem_type support the direct construction (see CellList::fill) the
+	 *       Verlet-list is constructed with multiple threads, with the exception of the
+	 *       neighborhood with radius
+	 *
+	 */
+	template<typename NN_type, int type> inline void create_(const openfpm::vector<Point<dim,T>> & pos, const openfpm::vector<Point<dim,T>> & pos2 , const openfpm::vector<size_t> & dom, const openfpm::vector<subsub_lin<dim>> & anom, T r_cut, size_t g_m, CellListImpl & cli, size_t opt)
+	{
+		create_impl<NN_type,type>(pos,pos2,dom,anom,r_cut,g_m,cli,opt,std::integral_constant<bool,has_set_n_elements<Mem_type>::value && type != WITH_RADIUS>());
+	}
+
 	/*! \brief Create the Verlet list from a given cell-list with a particular cut-off radius
 	 *
 	 * \param pos vector of positions of particles
@@ -440,7 +717,7 @@ public:
 	typedef Mem_type Mem_type_type;
 
 	//! Object type that the structure store
-	typedef size_t value_type;
+	typedef typename Mem_type::loc_index value_type;
 
 	//! CellList implementation used for Verlet list construction
 	typedef CellListImpl CellListImpl_;
@@ -461,7 +738,7 @@ public:
 	 * \param ele element to add
 	 *
 	 */
-	inline void addPart(size_t part_id, size_t ele)
+	inline void addPart(size_t part_id, typename Mem_type::loc_index ele)
 	{
 		Mem_type::addCell(part_id,ele);
 	}
@@ -485,6 +762,9 @@ public:
 
 		Box<dim,T> bt = box;
 
+		// Verlet radius
+		r_cut += skin;
+
 		// Calculate the divisions for the Cell-lists
 		cl_param_calculate(bt,div,r_cut,Ghost<dim,T>(0.0));
 
@@ -498,6 +778,7 @@ public:
 
 		// create verlet
 		create(pos, pos,dom_c,anom_c,r_cut,g_m,cli,opt);
+		saveRef(pos,g_m);
 	}
 
 	/*! \brief Initialize the symmetric Verlet-list
@@ -520,6 +801,9 @@ public:
 		// Cell decomposer
 		CellDecomposer_sm<dim,T,shift<dim,T>> cd_sm;
 
+		// Verlet radius
+		r_cut += skin;
+
 		// Calculate the divisions for the Cell-lists
 		cl_param_calculateSym<dim,T>(box,cd_sm,g,r_cut,pad);
 
@@ -533,6 +817,7 @@ public:
 
 		// create verlet
 		create(pos, pos,dom_c,anom_c,r_cut,g_m,cli,VL_SYMMETRIC);
+		saveRef(pos,g_m);
 	}
 
 
@@ -556,6 +841,9 @@ public:
 		// Cell decomposer
 		CellDecomposer_sm<dim,T,shift<dim,T>> cd_sm;
 
+		// Verlet radius
+		r_cut += skin;
+
 		// Calculate the divisions for the Cell-lists
 		cl_param_calculateSym<dim,T>(box,cd_sm,g,r_cut,pad);
 
@@ -577,7 +865,8 @@ public:
 	void createVerletCrs(T r_cut, size_t g_m, openfpm::vector<Point<dim,T>> & pos, openfpm::vector<size_t> & dom_c, openfpm::vector<subsub_lin<dim>> & anom_c)
 	{
 		// create verlet
-		create(pos, pos,dom_c,anom_c,r_cut,g_m,cli,VL_CRS_SYMMETRIC);
+		create(pos, pos,dom_c,anom_c,r_cut + skin,g_m,cli,VL_CRS_SYMMETRIC);
+		saveRef(pos,g_m);
 	}
 
 	/*! \brief update the Verlet list
@@ -588,16 +877,26 @@ public:
 	 * \param g_m ghost marker
 	 * \param opt option to create the Verlet list
 	 *
+	 * \note with a skin (see setSkin) the Verlet-list is reconstructed only if one particle moved
+	 *       more than skin/2 from the last construction, use isRebuilt() to know if it happened
+	 *
 	 */
 	void update(const Box<dim,T> & dom, T r_cut, openfpm::vector<Point<dim,T>> & pos, size_t & g_m, size_t opt)
 	{
+		if (needRebuild(pos,g_m) == false)
+		{
+			rebuilt = false;
+			return;
+		}
+
 		initCl(cli,pos,g_m,opt);
 
 		// Unused
 		openfpm::vector<subsub_lin<dim>> anom_c;
 		openfpm::vector<size_t> dom_c;
 
-		create(pos, pos,dom_c,anom_c,r_cut,g_m,cli,opt);
+		create(pos, pos,dom_c,anom_c,r_cut + skin,g_m,cli,opt);
+		saveRef(pos,g_m);
 	}
 
 	/*! \brief update the Verlet list
@@ -612,9 +911,16 @@ public:
 	 */
 	void updateCrs(const Box<dim,T> & dom, T r_cut, openfpm::vector<Point<dim,T>> & pos, size_t & g_m, const openfpm::vector<size_t> & dom_c, const openfpm::vector<subsub_lin<dim>> & anom_c)
 	{
+		if (needRebuild(pos,g_m) == false)
+		{
+			rebuilt = false;
+			return;
+		}
+
 		initCl(cli,pos,g_m,VL_CRS_SYMMETRIC);
 
-		create(pos,pos,dom_c,anom_c,r_cut,g_m,cli,VL_CRS_SYMMETRIC);
+		create(pos,pos,dom_c,anom_c,r_cut + skin,g_m,cli,VL_CRS_SYMMETRIC);
+		saveRef(pos,g_m);
 	}
 
 	/*! Initialize the verlet list from an already filled cell-list
@@ -637,6 +943,9 @@ public:
 	{
 		Point<dim,T> spacing = cli.getCellBox().getP2();
 
+		// Verlet radius
+		r_cut += skin;
+
 		// Create with radius or not
 		bool wr = true;
 
@@ -657,23 +966,25 @@ public:
 
 			create_<decltype(cli.template getNNIteratorRadius<NO_CHECK>(0,0.0)),WITH_RADIUS>(pos,pos2,dom_c,anom_c,r_cut,g_m,cli,VL_NON_SYMMETRIC);
 		}
+
+		saveRef(pos,g_m);
 	}
 
 	//! Default Constructor
 	VerletList()
-	:Mem_type(VERLET_STARTING_NSLOT),slot(VERLET_STARTING_NSLOT),n_dec(0)
+	:Mem_type(VERLET_STARTING_NSLOT),slot(VERLET_STARTING_NSLOT),n_dec(0),skin(0.0),g_m_last(0),rebuilt(false),n_thr(1)
 	{};
 
 	//! Copy constructor
 	VerletList(const VerletList<dim,T,Mem_type,transform,CellListImpl> & cell)
-	:Mem_type(VERLET_STARTING_NSLOT),slot(VERLET_STARTING_NSLOT)
+	:Mem_type(VERLET_STARTING_NSLOT),slot(VERLET_STARTING_NSLOT),skin(0.0),g_m_last(0),rebuilt(false),n_thr(1)
 	{
 		this->operator=(cell);
 	}
 
 	//! Copy constructor
 	VerletList(VerletList<dim,T,Mem_type,transform,CellListImpl> && cell)
-	:Mem_type(VERLET_STARTING_NSLOT),slot(VERLET_STARTING_NSLOT),n_dec(0)
+	:Mem_type(VERLET_STARTING_NSLOT),slot(VERLET_STARTING_NSLOT),n_dec(0),skin(0.0),g_m_last(0),rebuilt(false),n_thr(1)
 	{
 		this->operator=(cell);
 	}
@@ -689,7 +1000,7 @@ public:
 	 *
 	 */
 	VerletList(Box<dim,T> & box, T r_cut, Matrix<dim,T> mat, const size_t pad = 1, size_t slot=STARTING_NSLOT)
-	:slot(VERLET_STARTING_NSLOT),CellDecomposer_sm<dim,T,transform>(box,div,mat,box.getP1(),pad)
+	:slot(VERLET_STARTING_NSLOT),CellDecomposer_sm<dim,T,transform>(box,div,mat,box.getP1(),pad),skin(0.0),g_m_last(0),rebuilt(false),n_thr(1)
 	{
 		SpaceBox<dim,T> sbox(box);
 		Initialize(sbox,r_cut,pad,slot);
@@ -709,7 +1020,7 @@ public:
 	 *
 	 */
 	VerletList(Box<dim,T> & box, T r_cut, openfpm::vector<Point<dim,T>> & pos, size_t g_m, size_t slot=VERLET_STARTING_NSLOT)
-	:slot(slot)
+	:slot(slot),skin(0.0),g_m_last(0),rebuilt(false),n_thr(1)
 	{
 		SpaceBox<dim,T> sbox(box);
 		Initialize(sbox,r_cut,pos,g_m);
@@ -730,7 +1041,7 @@ public:
 	 *
 	 */
 	VerletList(SpaceBox<dim,T> & box, Box<dim,T> & dom, T r_cut, openfpm::vector<Point<dim,T>> & pos, size_t g_m, size_t slot=VERLET_STARTING_NSLOT)
-	:slot(slot)
+	:slot(slot),skin(0.0),g_m_last(0),rebuilt(false),n_thr(1)
 	{
 		Initialize(box,r_cut,pos);
 	}
@@ -759,6 +1070,12 @@ public:
 
 		n_dec = vl.n_dec;
 
+		skin = vl.skin;
+		pos_last.swap(vl.pos_last);
+		g_m_last = vl.g_m_last;
+		rebuilt = vl.rebuilt;
+		n_thr = vl.n_thr;
+
 		return *this;
 	}
 
@@ -780,6 +1097,12 @@ public:
 		dp = vl.dp;
 		n_dec = vl.n_dec;
 
+		skin = vl.skin;
+		pos_last = vl.pos_last;
+		g_m_last = vl.g_m_last;
+		rebuilt = vl.rebuilt;
+		n_thr = vl.n_thr;
+
 		return *this;
 	}
 
@@ -803,7 +1126,7 @@ public:
 	 * \return The element value
 	 *
 	 */
-	inline size_t get(size_t i, size_t j) const
+	inline typename Mem_type::loc_index get(size_t i, size_t j) const
 	{
 		return Mem_type::get(i,j);
 	}
@@ -827,6 +1150,24 @@ public:
 		size_t n_dec_tmp = vl.n_dec;
 		vl.n_dec = n_dec;
 		n_dec = n_dec_tmp;
+
+		T skin_tmp = vl.skin;
+		vl.skin = skin;
+		skin = skin_tmp;
+
+		pos_last.swap(vl.pos_last);
+
+		size_t g_m_last_tmp = vl.g_m_last;
+		vl.g_m_last = g_m_last;
+		g_m_last = g_m_last_tmp;
+
+		bool rebuilt_tmp = vl.rebuilt;
+		vl.rebuilt = rebuilt;
+		rebuilt = rebuilt_tmp;
+
+		size_t n_thr_tmp = vl.n_thr;
+		vl.n_thr = n_thr;
+		n_thr = n_thr_tmp;
 	}
 
 	/*! \brief Get the Neighborhood iterator
@@ -926,6 +1267,65 @@ public:
 		return n_dec;
 	}
 
+	/*! \brief Set the skin
+	 *
+	 * The Verlet-list is constructed with a radius r_cut + skin, and update() reconstruct it
+	 * only when one particle moved more than skin/2 from the last construction. It must be set
+	 * before the Verlet-list initialization
+	 *
+	 * \param skin skin
+	 *
+	 */
+	void setSkin(T skin)
+	{
+		this->skin = skin;
+	}
+
+	/*! \brief Set the maximum number of threads used to construct the Verlet-list
+	 *
+	 * By default the construction is serial. The threads are used only when compiled with
+	 * OpenMP (see --enable-openmp) and the memory structure can be written directly (Mem_fast,
+	 * Mem_compact). The same number of threads is used to fill the internal Cell-list
+	 *
+	 * \param n_thr number of threads (0 use omp_get_max_threads())
+	 *
+	 */
+	void setNThreads(size_t n_thr)
+	{
+		cli.setNThreads(n_thr);
+		this->n_thr = cli.getNThreads();
+	}
+
+	/*! \brief Get the maximum number of threads used to construct the Verlet-list
+	 *
+	 * \return the number of threads
+	 *
+	 */
+	size_t getNThreads() const
+	{
+		return n_thr;
+	}
+
+	/*! \brief Get the skin
+	 *
+	 * \return the skin
+	 *
+	 */
+	T getSkin() const
+	{
+		return skin;
+	}
+
+	/*! \brief Return true if the last update reconstructed the Verlet-list
+	 *
+	 * \return true if the Verlet-list has been reconstructed
+	 *
+	 */
+	bool isRebuilt() const
+	{
+		return rebuilt;
+	}
+
 	/*! \brief Return the domain particle sequence
 	 *
 	 * \return the particle sequence
@@ -145,7 +145,7 @@ class VerletListM : public VerletBase
 	typedef boost::high_bit_mask_t<sh_byte>  mask_high;
 
 	//! Mask to get the low bits of a number
-	typedef boost::low_bits_mask_t<sizeof(size_t)*8-sh_byte>  mask_low;
+	typedef boost::low_bits_mask_t<sizeof(typename VerletBase::Mem_type_type::loc_index)*8-sh_byte>  mask_low;
 
 	/*! \brief Create the Verlet list from a given cell-list
 	 *
@@ -316,7 +316,7 @@ public:
 	 */
 	inline size_t getV(size_t part, size_t ele) const
 	{
-		return (VerletBase::get(part,ele)) >> (sizeof(size_t)*8-sh_byte);
+		return (VerletBase::get(part,ele)) >> (sizeof(typename VerletBase::Mem_type_type::loc_index)*8-sh_byte);
 	}
 
 	/*! \brief Get the Neighborhood iterator
@@ -0,0 +1,311 @@
+/*
+ * VerletListMPhase.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETLISTMPHASE_HPP_
+#define OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETLISTMPHASE_HPP_
+
+#include "NN/VerletList/VerletNNIteratorMPhase.hpp"
+#include "NN/CellList/CellListMPhase.hpp"
+#include "VerletList.hpp"
+#include <limits>
+
+/*! \brief Multi-phase Verlet-list without bit-packing
+ *
+ * The neighborhood ids are stored in the base Verlet-list as they are, the phase of each
+ * neighborhood is stored in a parallel array of phase_type that use the same offsets of the
+ * neighborhood ids. The number of particles for each phase is not limited like in VerletListM,
+ * the number of phases is limited by phase_type. The particle itself is not included in its
+ * neighborhood.
+ *
+ * \note the base Verlet-list must store the neighborhood ids in a single contiguous array
+ *       (Mem_fast or Mem_compact), it is checked at compile time
+ *
+ * \snippet VerletList_test.hpp Usage of VerletListMPhase
+ *
+ * \tparam dim Dimensionality of the space
+ * \tparam T type of the space float, double ...
+ * \tparam CellListImpl Multi-phase Cell-list used to construct the Verlet-list
+ * \tparam transform transformation of the space
+ * \tparam VerletBase Base structure that store the neighborhood ids
+ * \tparam phase_type type used to store the phase of each neighborhood
+ *
+ */
+template<unsigned int dim,
+		 typename T,
+		 typename CellListImpl=CellListMPhase<dim,T>,
+		 typename transform = shift<dim,T>,
+		 typename VerletBase=VerletList<dim,T,Mem_fast<>,transform, size_t>,
+		 typename phase_type = unsigned short>
+class VerletListMPhase : public VerletBase
+{
+	// the phases use the offsets of the neighborhood ids, so they must be contiguous
+	static_assert(has_set_n_elements<typename VerletBase::Mem_type_type>::value == true,
+			"VerletListMPhase require a base Verlet-list with contiguous storage (Mem_fast or Mem_compact)");
+
+	//! Phase of each neighborhood (same offsets of the neighborhood ids)
+	openfpm::vector<phase_type> phase_m;
+
+	/*! \brief Offset of a neighborhood element in the array of the neighborhood ids
+	 *
+	 * \param ele reference to the neighborhood element
+	 *
+	 * \return the offset
+	 *
+	 */
+	inline size_t offset(const typename VerletBase::Mem_type_type::loc_index & ele) const
+	{
+		return &ele - &this->getStartId(0);
+	}
+
+	/*! \brief Store the phases in the order they has been added in the array of the phases
+	 *
+	 * It must be called when the construction of the neighborhood ids is completed, because
+	 * adding elements can reorganize the neighborhood ids
+	 *
+	 * \param ph phases for all the neighborhood in the order of construction
+	 * \param g_m number of particles
+	 *
+	 */
+	void set_phases(const openfpm::vector<phase_type> & ph, size_t g_m)
+	{
+		phase_m.clear();
+
+		if (g_m == 0)
+			return;
+
+		size_t sz = 0;
+		for (size_t i = 0 ; i < g_m ; i++)
+		{
+			size_t stop = offset(this->getStopId(i));
+			sz = (stop > sz)?stop:sz;
+		}
+
+		phase_m.resize(sz + 1);
+
+		size_t k = 0;
+		for (size_t i = 0 ; i < g_m ; i++)
+		{
+			size_t start = offset(this->getStartId(i));
+
+			for (size_t j = 0 ; j < VerletBase::getNNPart(i) ; j++)
+			{
+				phase_m.get(start + j) = ph.get(k);
+				k++;
+			}
+		}
+	}
+
+	/*! \brief Create the Verlet list from a given cell-list
+	 *
+	 * \tparam NN_type Neighborhood iterator type
+	 *
+	 * \param pos vector of positions
+	 * \param pos2 vector of positions of all the phases
+	 * \param pp phase of pos
+	 * \param r_cut cut-off radius to get the neighborhood particles
+	 * \param g_m construct the Verlet-list for the first g_m particles
+	 * \param cli Cell-list to use to construct the verlet list
+	 * \param opt options like VL_SYMMETRIC or VL_NON_SYMMETRIC
+	 *
+	 */
+	template<typename NN_type> inline void create_(const openfpm::vector<Point<dim,T>> & pos,
+			                                        const openfpm::vector<pos_v<dim,T>> & pos2,
+													size_t pp,
+													T r_cut,
+													size_t g_m,
+													CellListImpl & cli,
+													size_t opt)
+	{
+		if (cli.getNPhases() - 1 > std::numeric_limits<phase_type>::max())
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error the number of phases " << cli.getNPhases() << " does not fit the phase_type" << std::endl;
+			return;
+		}
+
+		this->init_to_zero(this->slot,g_m);
+
+		// phases in the order of construction
+		openfpm::vector<phase_type> ph;
+
+		// square of the cutting radius
+		T r_cut2 = r_cut * r_cut;
+
+		// iterate the particles
+		for (size_t i = 0 ; i < g_m ; i++)
+		{
+			Point<dim,T> xp = pos.template get<0>(i);
+
+			// Get the neighborhood of the particle
+			NN_type NN = getNN(xp,pp,i,pos,pos2,cli,std::integral_constant<bool,std::is_same<NN_type,decltype(cli.template getNNIterator<NO_CHECK>(0))>::value>());
+
+			while (NN.isNext())
+			{
+				size_t nnp = NN.getP();
+				size_t v = NN.getV();
+
+				Point<dim,T> xq = pos2.get(v).pos.template get<0>(nnp);
+
+				if ((v != pp || nnp != i) && xp.distance2(xq) < r_cut2)
+				{
+					this->addPart(i,nnp);
+					ph.add(v);
+				}
+
+				// Next particle
+				++NN;
+			}
+		}
+
+		set_phases(ph,g_m);
+	}
+
+	/*! \brief Get the full neighborhood iterator
+	 *
+	 * \return the NN iterator
+	 *
+	 */
+	inline auto getNN(const Point<dim,T> & xp,
+			          size_t pp,
+					  size_t p,
+					  const openfpm::vector<Point<dim,T>> & pos,
+					  const openfpm::vector<pos_v<dim,T>> & pos2,
+					  CellListImpl & cli,
+					  std::true_type) -> decltype(cli.template getNNIterator<NO_CHECK>(0))
+	{
+		return cli.template getNNIterator<NO_CHECK>(cli.getCell(xp));
+	}
+
+	/*! \brief Get the symmetric neighborhood iterator
+	 *
+	 * \return the NN iterator
+	 *
+	 */
+	inline auto getNN(const Point<dim,T> & xp,
+			          size_t pp,
+					  size_t p,
+					  const openfpm::vector<Point<dim,T>> & pos,
+					  const openfpm::vector<pos_v<dim,T>> & pos2,
+					  CellListImpl & cli,
+					  std::false_type) -> decltype(cli.template getNNIteratorSym<NO_CHECK>(0,0,0,pos,pos2))
+	{
+		return cli.template getNNIteratorSym<NO_CHECK>(cli.getCell(xp),pp,p,pos,pos2);
+	}
+
+public:
+
+	//! Object type that the structure store
+	typedef typename VerletBase::Mem_type_type::loc_index value_type;
+
+	//! Multi-phase Cell-list used for the Verlet-list construction
+	typedef CellListImpl CellListImpl_;
+
+	//! type used to store the phases
+	typedef phase_type phase_type_;
+
+	/*! Initialize the verlet list from an already filled multi-phase cell-list
+	 *
+	 * \param cli external multi-phase Cell-list
+	 * \param pp phase of pos
+	 * \param r_cut cutoff-radius
+	 * \param pos vector of particle positions
+	 * \param pos2 vector of particle position of all the phases
+	 * \param g_m Indicate form which particles to construct the verlet list. For example
+	 * 			if we have 120 particles and g_m = 100, the Verlet list will be constructed only for the first
+	 * 			100 particles
+	 * 	\param opt options for the Verlet-list creation (VL_NON_SYMMETRIC or VL_SYMMETRIC)
+	 *
+	 */
+	void Initialize(CellListImpl & cli, size_t pp, T r_cut, const openfpm::vector<Point<dim,T>> & pos, const openfpm::vector<struct pos_v<dim,T>> & pos2, size_t g_m, size_t opt = VL_NON_SYMMETRIC)
+	{
+		Point<dim,T> spacing = cli.getCellBox().getP2();
+
+		// Create with radius or not
+		bool wr = true;
+
+		for (size_t i = 0 ; i < dim ; i++)
+		{wr &= r_cut <= spacing.get(i);}
+
+		if (wr == false)
+		{
+			std::cerr << __FILE__ << ":" << __LINE__ << " error iterator with radius is not implemented yet " << std::endl;
+			return;
+		}
+
+		if (opt == VL_SYMMETRIC)
+			create_<decltype(cli.template getNNIteratorSym<NO_CHECK>(0,0,0,pos,pos2))>(pos,pos2,pp,r_cut,g_m,cli,opt);
+		else if (opt == VL_NON_SYMMETRIC)
+			create_<decltype(cli.template getNNIterator<NO_CHECK>(0))>(pos,pos2,pp,r_cut,g_m,cli,opt);
+		else
+			std::cerr << __FILE__ << ":" << __LINE__ << " error only VL_NON_SYMMETRIC and VL_SYMMETRIC are supported " << std::endl;
+	}
+
+	/*! \brief Get the particle id of the neighborhood ele of the particle part
+	 *
+	 * \param part part id
+	 * \param ele element id
+	 *
+	 * \return The particle id
+	 *
+	 */
+	inline size_t getP(size_t part, size_t ele) const
+	{
+		return VerletBase::get(part,ele);
+	}
+
+	/*! \brief Get the phase of the neighborhood ele of the particle part
+	 *
+	 * \param part particle id
+	 * \param ele element id
+	 *
+	 * \return The phase
+	 *
+	 */
+	inline size_t getV(size_t part, size_t ele) const
+	{
+		return phase_m.get(offset(this->getStartId(part)) + ele);
+	}
+
+	/*! \brief Return the first phase of the neighborhood of a particle
+	 *
+	 * \param part_id particle id
+	 *
+	 * \return reference to the first phase
+	 *
+	 */
+	inline const phase_type & getPhaseStart(size_t part_id)
+	{
+		return *(&phase_m.get(0) + offset(this->getStartId(part_id)));
+	}
+
+	/*! \brief Get the Neighborhood iterator
+	 *
+	 * It iterate across all the neighborhood particles of a selected particle
+	 *
+	 * \param part_id particle id
+	 *
+	 * \return an interator across the neighborhood particles
+	 *
+	 */
+	template<unsigned int impl=NO_CHECK> inline VerletNNIteratorMPhase<dim,VerletListMPhase<dim,T,CellListImpl,transform,VerletBase,phase_type>> getNNIterator(size_t part_id)
+	{
+		VerletNNIteratorMPhase<dim,VerletListMPhase<dim,T,CellListImpl,transform,VerletBase,phase_type>> vln(part_id,*this);
+
+		return vln;
+	}
+
+	/*! \brief Clear the Verlet-list
+	 *
+	 */
+	void clear()
+	{
+		VerletBase::clear();
+		phase_m.clear();
+	}
+};
+
+
+#endif /* OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETLISTMPHASE_HPP_ */
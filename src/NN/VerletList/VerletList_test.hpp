@@ -10,6 +10,8 @@
 
 #include "NN/VerletList/VerletList.hpp"
 #include "NN/VerletList/VerletListM.hpp"
+#include "NN/VerletList/VerletListDelta.hpp"
+#include "NN/VerletList/VerletListMPhase.hpp"
 
 /*! \brief create a vector of particles on a grid between 0.0 and 1.0
  *
@@ -182,7 +184,7 @@ template<unsigned int dim, typename T, typename VerS> void Verlet_list_s(SpaceBo
 	//! [Fill external cell list]
 
 	// Initialize an external cell-list
-	CellList<dim,T,Mem_fast<>,shift<3,double>> cli;
+	typename VerS::CellListImpl_ cli;
 	Box<dim,T> bt = box;
 
 	// Calculate the divisions for the Cell-lists
@@ -469,6 +471,336 @@ template<unsigned int dim, typename T, typename VerS> void Verlet_list_sM(SpaceB
 }
 
 
+/*! \brief Test that the multi-threaded construction produce the same Verlet-list of the serial one
+ *
+ * \tparam VerS Verlet-list type
+ *
+ */
+template<typename VerS> void Verlet_list_mt()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	double r_cut = 0.1;
+	Ghost<3,double> g(r_cut);
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 4096 ; i++)
+	{
+		Point<3,double> p;
+
+		// cluster half of the particles in a corner
+		double sc = (i % 2)?1.0:0.3;
+
+		p.get(0) = sc * (double)rand() / RAND_MAX;
+		p.get(1) = sc * (double)rand() / RAND_MAX;
+		p.get(2) = sc * (double)rand() / RAND_MAX;
+
+		pos.add(p);
+	}
+
+	size_t g_m = pos.size() * 3 / 4;
+
+	for (size_t opt = VL_NON_SYMMETRIC ; opt <= VL_CRS_SYMMETRIC ; opt++)
+	{
+		VerS vl[2];
+
+		for (size_t k = 0 ; k < 2 ; k++)
+		{
+			// serial and multi-threaded (more threads than cores) construction
+			vl[k].setNThreads((k == 0)?1:4);
+
+			if (opt == VL_NON_SYMMETRIC)
+				vl[k].Initialize(box,box,r_cut,pos,g_m);
+			else if (opt == VL_SYMMETRIC)
+				vl[k].InitializeSym(box,box,g,r_cut,pos,g_m);
+			else
+			{
+				vl[k].InitializeCrs(box,box,g,r_cut,pos,g_m);
+
+				// all the cells that are not padding have a normal neighborhood
+				auto & cli = vl[k].getInternalCellList();
+
+				openfpm::vector<size_t> dom_c;
+				openfpm::vector<subsub_lin<3>> anom_c;
+
+				for (size_t c = 0 ; c < cli.getGrid().size() ; c++)
+				{
+					grid_key_dx<3> key = cli.getGrid().InvLinId(c);
+
+					bool inside = true;
+					for (size_t j = 0 ; j < 3 ; j++)
+						inside &= (size_t)key.get(j) >= cli.getPadding(j) && (size_t)key.get(j) < cli.getGrid().size(j) - cli.getPadding(j);
+
+					if (inside == true)
+						dom_c.add(c);
+				}
+
+				vl[k].createVerletCrs(r_cut,g_m,pos,dom_c,anom_c);
+			}
+		}
+
+		BOOST_REQUIRE_EQUAL(vl[0].size(),vl[1].size());
+
+		size_t tot = 0;
+
+		for (size_t i = 0 ; i < vl[0].size() ; i++)
+		{
+			BOOST_REQUIRE_EQUAL(vl[0].getNNPart(i),vl[1].getNNPart(i));
+
+			for (size_t j = 0 ; j < vl[0].getNNPart(i) ; j++)
+				BOOST_REQUIRE_EQUAL(vl[0].get(i,j),vl[1].get(i,j));
+
+			tot += vl[0].getNNPart(i);
+		}
+
+		BOOST_REQUIRE(tot != 0);
+
+		auto & dp0 = vl[0].getParticleSeq();
+		auto & dp1 = vl[1].getParticleSeq();
+
+		BOOST_REQUIRE_EQUAL(dp0.size(),dp1.size());
+
+		for (size_t i = 0 ; i < dp0.size() ; i++)
+			BOOST_REQUIRE_EQUAL(dp0.get(i),dp1.get(i));
+	}
+}
+
+/*! \brief Test the Verlet-list with skin
+ *
+ * \tparam VerS Verlet-list type
+ *
+ */
+template<typename VerS> void Verlet_list_skin()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	double r_cut = 0.1;
+	double skin = 0.02;
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 4096 ; i++)
+	{
+		Point<3,double> p;
+
+		p.get(0) = 0.1 + 0.8 * (double)rand() / RAND_MAX;
+		p.get(1) = 0.1 + 0.8 * (double)rand() / RAND_MAX;
+		p.get(2) = 0.1 + 0.8 * (double)rand() / RAND_MAX;
+
+		pos.add(p);
+	}
+
+	size_t g_m = pos.size();
+
+	VerS vl;
+	vl.setSkin(skin);
+	vl.Initialize(box,box,r_cut,pos,g_m);
+
+	BOOST_REQUIRE_EQUAL(vl.isRebuilt(),true);
+
+	for (size_t step = 0 ; step < 8 ; step++)
+	{
+		// move the particles of skin/7 for each step
+
+		for (size_t i = 0 ; i < pos.size() ; i++)
+		{
+			for (size_t j = 0 ; j < 3 ; j++)
+				pos.template get<0>(i)[j] += (((i+j) % 2)?1.0:-1.0) * skin / 7.0 / sqrt(3.0);
+		}
+
+		vl.update(box,r_cut,pos,g_m,VL_NON_SYMMETRIC);
+
+		// the displacement exceed skin/2 every 4 steps
+		BOOST_REQUIRE_EQUAL(vl.isRebuilt(),step % 4 == 3);
+
+		// Check that all the particles in r_cut are in the list
+
+		for (size_t i = 0 ; i < pos.size() ; i += 8)
+		{
+			Point<3,double> xp = pos.template get<0>(i);
+
+			size_t n_in = 0;
+
+			for (size_t j = 0 ; j < vl.getNNPart(i) ; j++)
+			{
+				Point<3,double> xq = pos.template get<0>(vl.get(i,j));
+
+				if (xp.distance2(xq) < r_cut*r_cut)
+					n_in++;
+			}
+
+			size_t n_brute = 0;
+
+			for (size_t j = 0 ; j < pos.size() ; j++)
+			{
+				Point<3,double> xq = pos.template get<0>(j);
+
+				if (xp.distance2(xq) < r_cut*r_cut)
+					n_brute++;
+			}
+
+			BOOST_REQUIRE_EQUAL(n_in,n_brute);
+		}
+	}
+}
+
+/*! \brief Check that the delta-encoded Verlet-list iterate the same neighborhood of the original
+ *
+ * \tparam delta_type type of the differences
+ *
+ */
+template<typename delta_type> void Verlet_list_delta()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	double r_cut = 0.1;
+
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 4096 ; i++)
+	{
+		Point<3,double> p({(double)rand() / RAND_MAX,(double)rand() / RAND_MAX,(double)rand() / RAND_MAX});
+		pos.add(p);
+	}
+
+	VerletList<3,double,Mem_fast<>,shift<3,double>> vl;
+	vl.Initialize(box,box,r_cut,pos,pos.size());
+
+	//! [Usage of VerletListDelta]
+
+	VerletListDelta<delta_type> vd;
+	vd.compress(vl);
+
+	size_t tot = 0;
+
+	for (size_t p = 0 ; p < pos.size() ; p++)
+	{
+		auto NN = vd.getNNIterator(p);
+
+		//! [Usage of VerletListDelta]
+
+		BOOST_REQUIRE_EQUAL(vd.getNNPart(p),vl.getNNPart(p));
+
+		size_t j = 0;
+		while (NN.isNext())
+		{
+			BOOST_REQUIRE_EQUAL(NN.get(),vl.get(p,j));
+
+			j++;
+			++NN;
+		}
+
+		BOOST_REQUIRE_EQUAL(j,vl.getNNPart(p));
+		tot += j;
+	}
+
+	// with 16 bit or more all the differences fit
+
+	if (sizeof(delta_type) >= 2)
+		BOOST_REQUIRE_EQUAL(vd.getNEncoded(),tot);
+	else
+		BOOST_REQUIRE(vd.getNEncoded() > tot);
+}
+
+/*! \brief Test the multi-phase Verlet-list without bit-packing against a brute force search
+ *
+ * \tparam VerS multi-phase Verlet-list
+ *
+ */
+template<typename VerS> void Verlet_list_mphase()
+{
+	Box<3,double> box({0.0,0.0,0.0},{1.0,1.0,1.0});
+	size_t div[3] = {10,10,10};
+	double r_cut = 0.1;
+
+	openfpm::vector<Point<3,double>> phase0;
+	openfpm::vector<Point<3,double>> phase1;
+	openfpm::vector<Point<3,double>> phase2;
+
+	openfpm::vector<pos_v<3,double>> phases;
+	phases.add(pos_v<3,double>(phase0));
+	phases.add(pos_v<3,double>(phase1));
+	phases.add(pos_v<3,double>(phase2));
+
+	for (size_t v = 0 ; v < phases.size() ; v++)
+	{
+		for (size_t i = 0 ; i < 300 + 100*v ; i++)
+		{
+			Point<3,double> p({(double)rand() / RAND_MAX,(double)rand() / RAND_MAX,(double)rand() / RAND_MAX});
+			phases.get(v).pos.add(p);
+		}
+	}
+
+	//! [Usage of VerletListMPhase]
+
+	typename VerS::CellListImpl_ cli;
+	cli.Initialize(box,div,phases.size());
+
+	for (size_t v = 0 ; v < phases.size() ; v++)
+		cli.fill(v,phases.get(v).pos,phases.get(v).pos.size());
+
+	VerS ver;
+	VerS ver_sym;
+
+	//! [Usage of VerletListMPhase]
+
+	size_t n_pair_sym = 0;
+	size_t n_pair_bf = 0;
+
+	for (size_t pp = 0 ; pp < phases.size() ; pp++)
+	{
+		openfpm::vector<Point<3,double>> & pos = phases.get(pp).pos;
+
+		ver.Initialize(cli,pp,r_cut,pos,phases,pos.size());
+		ver_sym.Initialize(cli,pp,r_cut,pos,phases,pos.size(),VL_SYMMETRIC);
+
+		for (size_t p = 0 ; p < pos.size() ; p++)
+		{
+			Point<3,double> xp = pos.template get<0>(p);
+
+			size_t n_bf = 0;
+			size_t sum_bf = 0;
+
+			for (size_t vq = 0 ; vq < phases.size() ; vq++)
+			{
+				for (size_t q = 0 ; q < phases.get(vq).pos.size() ; q++)
+				{
+					if (vq == pp && q == p)	continue;
+
+					Point<3,double> xq = phases.get(vq).pos.template get<0>(q);
+
+					if (xp.distance2(xq) < r_cut*r_cut)
+					{
+						n_bf++;
+						sum_bf += vq*10000 + q;
+					}
+				}
+			}
+
+			size_t sum = 0;
+			size_t sum_it = 0;
+
+			for (size_t j = 0 ; j < ver.getNNPart(p) ; j++)
+				sum += ver.getV(p,j)*10000 + ver.getP(p,j);
+
+			auto NN = ver.getNNIterator(p);
+
+			while (NN.isNext())
+			{
+				sum_it += NN.getV()*10000 + NN.getP();
+				++NN;
+			}
+
+			BOOST_REQUIRE_EQUAL(ver.getNNPart(p),n_bf);
+			BOOST_REQUIRE_EQUAL(sum,sum_bf);
+			BOOST_REQUIRE_EQUAL(sum_it,sum_bf);
+
+			n_pair_sym += ver_sym.getNNPart(p);
+			n_pair_bf += n_bf;
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(2*n_pair_sym,n_pair_bf);
+}
+
 BOOST_AUTO_TEST_SUITE( VerletList_test )
 
 BOOST_AUTO_TEST_CASE( VerletList_use)
@@ -480,6 +812,10 @@ BOOST_AUTO_TEST_CASE( VerletList_use)
 //	Verlet_list_s<3,double,VerletList<3,double,FAST,shift<3,double>>>(box);
 //	Verlet_list_s<3,double,VerletList<3,double,FAST,shift<3,double>> >(box2);
 	Verlet_list_sM<3,double,VerletListM<3,double,2>>(box);
+
+	Verlet_list_s<3,double,VerletList<3,double,Mem_fast<>,shift<3,double>>>(box);
+	Verlet_list_s<3,double,VerletList<3,double,Mem_compact<>,shift<3,double>>>(box);
+	Verlet_list_s<3,double,VerletList<3,double,Mem_fast<unsigned int>,shift<3,double>>>(box);
 //	Verlet_list_sM<3,double,CellListM<3,double,8>>(box2);
 
 	std::cout << "End verlet list" << "\n";
@@ -487,6 +823,80 @@ BOOST_AUTO_TEST_CASE( VerletList_use)
 	// Test the cell list
 }
 
+BOOST_AUTO_TEST_CASE( VerletList_mt )
+{
+	Verlet_list_mt<VerletList<3,double,Mem_fast<>,shift<3,double>>>();
+	Verlet_list_mt<VerletList<3,double,Mem_compact<>,shift<3,double>>>();
+	Verlet_list_mt<VerletList<3,double,Mem_fast<unsigned int>,shift<3,double>>>();
+}
+
+BOOST_AUTO_TEST_CASE( VerletList_dist_filter )
+{
+	openfpm::vector<Point<3,double>> pos;
+
+	for (size_t i = 0 ; i < 1000 ; i++)
+	{
+		Point<3,double> p;
+
+		p.get(0) = (double)rand() / RAND_MAX;
+		p.get(1) = (double)rand() / RAND_MAX;
+		p.get(2) = (double)rand() / RAND_MAX;
+
+		pos.add(p);
+	}
+
+	VerletDistFilter<3,double,size_t> flt;
+
+	Point<3,double> xp({0.5,0.5,0.5});
+	double r_cut2 = 0.3*0.3;
+
+	// Add the candidates in a scrambled order with different number of candidates
+
+	for (size_t n_c = 0 ; n_c < 1000 ; n_c += 37)
+	{
+		flt.clear();
+
+		for (size_t k = 0 ; k < n_c ; k++)
+			flt.add((k*7) % 1000,pos);
+
+		size_t n = flt.filter(xp,r_cut2);
+
+		size_t cnt = 0;
+		for (size_t k = 0 ; k < n_c ; k++)
+		{
+			Point<3,double> xq = pos.template get<0>((k*7) % 1000);
+
+			if (xp.distance2(xq) < r_cut2)
+			{
+				BOOST_REQUIRE_EQUAL(flt.get(cnt),(k*7) % 1000);
+				cnt++;
+			}
+		}
+
+		BOOST_REQUIRE_EQUAL(n,cnt);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( VerletList_delta )
+{
+	Verlet_list_delta<signed char>();
+	Verlet_list_delta<short int>();
+	Verlet_list_delta<int>();
+}
+
+BOOST_AUTO_TEST_CASE( VerletList_multi_phase )
+{
+	Verlet_list_mphase<VerletListMPhase<3,double>>();
+	Verlet_list_mphase<VerletListMPhase<3,double,CellListMPhase<3,double,CellList<3,double,Mem_fast<unsigned int>,shift<3,double>>>,shift<3,double>,VerletList<3,double,Mem_fast<unsigned int>,shift<3,double>>>>();
+	Verlet_list_mphase<VerletListMPhase<3,double,CellListMPhase<3,double>,shift<3,double>,VerletList<3,double,Mem_compact<>,shift<3,double>>,unsigned char>>();
+}
+
+BOOST_AUTO_TEST_CASE( VerletList_skin )
+{
+	Verlet_list_skin<VerletList<3,double,Mem_fast<>,shift<3,double>>>();
+	Verlet_list_skin<VerletList<3,double,Mem_fast<unsigned int>,shift<3,double>>>();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
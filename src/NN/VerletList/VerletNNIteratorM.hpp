@@ -27,7 +27,7 @@ template<unsigned int dim, typename Ver, unsigned int sh_byte> class VerletNNIte
 	typedef boost::high_bit_mask_t<sh_byte>  mask_high;
 
 	//! Mask to get the low bits of a number
-	typedef boost::low_bits_mask_t<sizeof(size_t)*8-sh_byte>  mask_low;
+	typedef boost::low_bits_mask_t<sizeof(typename Ver::Mem_type_type::loc_index)*8-sh_byte>  mask_low;
 
 
 public:
@@ -58,7 +58,7 @@ public:
 	 */
 	inline size_t getV()
 	{
-		return (VerletNNIterator<dim,Ver>::get()) >> (sizeof(size_t)*8-sh_byte);
+		return (VerletNNIterator<dim,Ver>::get()) >> (sizeof(typename Ver::Mem_type_type::loc_index)*8-sh_byte);
 	}
 
 
@@ -0,0 +1,94 @@
+/*
+ * VerletNNIteratorMPhase.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETNNITERATORMPHASE_HPP_
+#define OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETNNITERATORMPHASE_HPP_
+
+/*! \brief Iterator for the neighborhood of a multi-phase Verlet-list without bit-packing
+ *
+ * In general you never create it directly but you get it from VerletListMPhase
+ *
+ * It walk in parallel the neighborhood ids and the neighborhood phases
+ *
+ * \tparam dim dimensionality of the space where the cell live
+ * \tparam Ver multi-phase Verlet-list
+ *
+ */
+template<unsigned int dim, typename Ver> class VerletNNIteratorMPhase
+{
+	//! actual neighborhood
+	const typename Ver::Mem_type_type::loc_index * ele_id;
+
+	//! stop index for the neighborhood
+	const typename Ver::Mem_type_type::loc_index * stop;
+
+	//! actual phase of the neighborhood
+	const typename Ver::phase_type_ * ph_id;
+
+	//! verlet list
+	Ver & ver;
+
+public:
+
+	/*! \brief Constructor for the Verlet iterator Multi-phase
+	 *
+	 * \param part_id Particle id
+	 * \param ver Verlet-list
+	 *
+	 */
+	inline VerletNNIteratorMPhase(size_t part_id, Ver & ver)
+	:ele_id(&ver.getStart(part_id)),stop(&ver.getStop(part_id)),ph_id(&ver.getPhaseStart(part_id)),ver(ver)
+	{}
+
+	/*! \brief Check if there is the next element
+	 *
+	 * \return true if there is the next element
+	 *
+	 */
+	inline bool isNext()
+	{
+		if (ele_id < stop)
+			return true;
+		return false;
+	}
+
+	/*! \brief take the next element
+	 *
+	 * \return itself
+	 *
+	 */
+	inline VerletNNIteratorMPhase & operator++()
+	{
+		ele_id++;
+		ph_id++;
+
+		return *this;
+	}
+
+	/*! \brief Get the particle id of the neighborhood
+	 *
+	 * \return the particle id
+	 *
+	 */
+	inline typename Ver::Mem_type_type::loc_index getP()
+	{
+		return ver.get_lin(ele_id);
+	}
+
+	/*! \brief Get the phase of the neighborhood
+	 *
+	 * \return the phase
+	 *
+	 */
+	inline size_t getV()
+	{
+		return *ph_id;
+	}
+};
+
+
+#endif /* OPENFPM_DATA_SRC_NN_VERLETLIST_VERLETNNITERATORMPHASE_HPP_ */
@@ -39,6 +39,8 @@
 #include "map_vector_std_util.hpp"
 #include "data_type/aggregate.hpp"
 #include "vector_map_iterator.hpp"
+#include "map_vector_block_move.hpp"
+#include "map_vector_sort.hpp"
 
 namespace openfpm
 {
@@ -117,6 +119,55 @@ namespace openfpm
 			{sz[0] = arg;}
 		}
 
+		/*! \brief Fill the holes left by the removed keys with the elements of the tail
+		 *
+		 * \param keys objects id to remove (sorted)
+		 * \param start key starting point
+		 * \param reloc if not NULL the moved elements are recorded (old position, new position)
+		 *
+		 */
+		void remove_unordered_impl(const openfpm::vector<size_t> & keys, size_t start, openfpm::vector<std::pair<size_t,size_t>> * reloc)
+		{
+#ifdef SE_CLASS2
+			check_valid(this,8);
+#endif
+			// Nothing to remove return
+			if (keys.size() <= start )
+				return;
+
+			size_t new_size = size() - (keys.size() - start);
+
+			// one after the last element not yet used to fill a hole
+			size_t last = size();
+
+			// one after the last key not yet skipped in the tail
+			size_t b = keys.size();
+
+			for (size_t a = start ; a < keys.size() ; a++)
+			{
+				size_t hole = keys.get(a);
+
+				// the remaining holes are in the tail and disappear
+				if (hole >= new_size)
+					break;
+
+				// get the last element that is not going to be removed
+				last--;
+				while (b > a + 1 && keys.get(b-1) == last)
+				{
+					b--;
+					last--;
+				}
+
+				set(hole,*this,last);
+
+				if (reloc != NULL)
+					reloc->add(std::pair<size_t,size_t>(last,hole));
+			}
+
+			v_size = new_size;
+		}
+
 #ifdef SE_CLASS1
 
 		/*! \brief Check that id is not bigger than the vector size
@@ -563,6 +614,8 @@ namespace openfpm
 		}
 
 		/*! \brief Insert an entry in the vector
+		 *
+		 * If T does not have pointers the elements after key are shifted with memmove
 		 *
 		 * \size_t key Where to insert the element
 		 *
@@ -574,6 +627,14 @@ namespace openfpm
 #endif
 			add();
 
+			// without pointers the elements are shifted with memmove
+			if (check_no_pointers<T>::value() == PNP::NO_POINTERS)
+			{
+				if (key + 1 < size())
+					block_move<T,layout_base<T>>::move(base,key+1,key,size()-key-1);
+				return;
+			}
+
 			long int d_k = (long int)size()-1;
 			long int s_k = (long int)size()-2;
 
@@ -588,6 +649,8 @@ namespace openfpm
 
 
 		/*! \brief Remove one entry from the vector
+		 *
+		 * If T does not have pointers the elements after key are shifted with memmove
 		 *
 		 * \param key element to remove
 		 *
@@ -597,6 +660,16 @@ namespace openfpm
 #ifdef SE_CLASS2
 			check_valid(this,8);
 #endif
+			// without pointers the elements are shifted with memmove
+			if (check_no_pointers<T>::value() == PNP::NO_POINTERS)
+			{
+				if (key + 1 < size())
+					block_move<T,layout_base<T>>::move(base,key,key+1,size()-key-1);
+
+				v_size--;
+				return;
+			}
+
 			size_t d_k = key;
 			size_t s_k = key + 1;
 
@@ -614,6 +687,9 @@ namespace openfpm
 		}
 
 		/*! \brief Remove several entries from the vector
+		 *
+		 * If T does not have pointers the blocks of elements between the keys are moved
+		 * with memmove
 		 *
 		 * \warning the keys in the vector MUST be sorted
 		 *
@@ -630,6 +706,32 @@ namespace openfpm
 			if (keys.size() <= start )
 				return;
 
+			// without pointers the blocks between the keys are shifted with memmove
+			if (check_no_pointers<T>::value() == PNP::NO_POINTERS)
+			{
+				size_t d_k = keys.get(start);
+
+				for (size_t a = start ; a < keys.size() ; a++)
+				{
+					size_t s_k = keys.get(a) + 1;
+
+					// In case of overflow
+					if (s_k >= size())
+						break;
+
+					size_t e_k = (a+1 < keys.size() && keys.get(a+1) < size())?keys.get(a+1):size();
+
+					if (e_k > s_k)
+					{
+						block_move<T,layout_base<T>>::move(base,d_k,s_k,e_k - s_k);
+						d_k += e_k - s_k;
+					}
+				}
+
+				v_size -= keys.size() - start;
+				return;
+			}
+
 			size_t a_key = start;
 			size_t d_k = keys.get(a_key);
 			size_t s_k = keys.get(a_key) + 1;
@@ -658,6 +760,42 @@ namespace openfpm
 			v_size -= keys.size() - start;
 		}
 
+		/*! \brief Remove several entries from the vector without preserving the order
+		 *
+		 * Every hole is filled with the last element of the vector that is not going to be
+		 * removed, so only the removed elements that are not in the tail are overwritten and
+		 * the cost is O(keys.size()) instead of O(size())
+		 *
+		 * \snippet vector_unit_tests.hpp Remove unordered
+		 *
+		 * \warning the keys in the vector MUST be sorted, unique and smaller than size()
+		 *
+		 * \param keys objects id to remove
+		 * \param reloc for each moved element the pair (old position, new position)
+		 * \param start key starting point
+		 *
+		 */
+		void remove_unordered(const openfpm::vector<size_t> & keys, openfpm::vector<std::pair<size_t,size_t>> & reloc, size_t start = 0)
+		{
+			reloc.clear();
+			remove_unordered_impl(keys,start,&reloc);
+		}
+
+		/*! \brief Remove several entries from the vector without preserving the order
+		 *
+		 * \see remove_unordered(keys,reloc,start)
+		 *
+		 * \warning the keys in the vector MUST be sorted, unique and smaller than size()
+		 *
+		 * \param keys objects id to remove
+		 * \param start key starting point
+		 *
+		 */
+		void remove_unordered(const openfpm::vector<size_t> & keys, size_t start = 0)
+		{
+			remove_unordered_impl(keys,start,NULL);
+		}
+
 		/*! \brief Get an element of the vector
 		 *
 		 * Get an element of the vector
@@ -964,6 +1102,124 @@ namespace openfpm
 			base.set(id,v.base,src);
 		}
 
+		/*! \brief Reorder the elements of the vector
+		 *
+		 * After the call the element i is the element perm.get(i) before the call.
+		 * If T does not have pointers the vector is gathered in a new buffer with one pass
+		 * for each property (memcpy), otherwise the permutation is applied in place following
+		 * its cycles and only one element is used as temporal storage
+		 *
+		 * \param perm permutation (perm.get(i) is the old position of the new element i)
+		 *
+		 */
+		void permute(const openfpm::vector<size_t> & perm)
+		{
+#ifdef SE_CLASS2
+			check_valid(this,8);
+#endif
+#ifdef SE_CLASS1
+			if (perm.size() != size())
+				std::cerr << "Error " << __FILE__ << ":" << __LINE__ << " the permutation has size " << perm.size() << " but the vector has size " << size() << "\n";
+#endif
+
+			if (size() == 0)
+				return;
+
+			if (check_no_pointers<T>::value() == PNP::NO_POINTERS)
+			{
+				vector<T,Memory,layout,layout_base,grow_p,OPENFPM_NATIVE> tmp;
+				tmp.resize(size());
+
+				block_gather<T,layout_base<T>>::gather(tmp.base,base,&perm.get(0),size());
+
+				base.swap(tmp.base);
+				return;
+			}
+
+			// temporal storage
+			vector<T,Memory,layout,layout_base,grow_p,OPENFPM_NATIVE> tmp;
+			tmp.resize(1);
+
+			std::vector<bool> done(size(),false);
+
+			for (size_t i = 0 ; i < size() ; i++)
+			{
+				if (done[i] == true || perm.get(i) == i)
+					continue;
+
+				// follow the cycle starting from i
+
+				tmp.set(0,*this,i);
+
+				size_t j = i;
+				done[j] = true;
+
+				while (perm.get(j) != i)
+				{
+					set(j,*this,perm.get(j));
+					j = perm.get(j);
+					done[j] = true;
+				}
+
+				set(j,tmp,0);
+			}
+		}
+
+		/*! \brief Sort the vector by an integer key
+		 *
+		 * The permutation that sort the keys is calculated with a parallel stable radix sort
+		 * (radix_sort_perm) and applied to all the properties with permute. The keys are not
+		 * reordered
+		 *
+		 * \snippet vector_unit_tests.hpp Sort a vector by key
+		 *
+		 * \param keys one integer key for each element
+		 * \param perm output permutation (perm.get(i) is the old position of the new element i),
+		 *        it can be used to reorder other structures
+		 *
+		 */
+		template<typename key_type> void sort_by_key(const openfpm::vector<key_type> & keys, openfpm::vector<size_t> & perm)
+		{
+#ifdef SE_CLASS1
+			if (keys.size() != size())
+				std::cerr << "Error " << __FILE__ << ":" << __LINE__ << " the keys has size " << keys.size() << " but the vector has size " << size() << "\n";
+#endif
+			perm.resize(size());
+
+			if (size() == 0)
+				return;
+
+			radix_sort_perm(&keys.get(0),size(),&perm.get(0));
+			permute(perm);
+		}
+
+		/*! \brief Sort the vector by an integer property
+		 *
+		 * \see sort_by_key
+		 *
+		 * \tparam prp property used as key (must be an integer)
+		 *
+		 * \param perm output permutation (perm.get(i) is the old position of the new element i)
+		 *
+		 */
+		template<unsigned int prp> void sort_by(openfpm::vector<size_t> & perm)
+		{
+			typedef typename std::remove_const<typename std::remove_reference<decltype(this->template get<prp>(0))>::type>::type key_type;
+
+			std::vector<key_type> keys(size());
+
+			for (size_t i = 0 ; i < size() ; i++)
+				keys[i] = this->template get<prp>(i);
+
+			perm.resize(size());
+
+			if (size() == 0)
+				return;
+
+			radix_sort_perm(keys.data(),size(),&perm.get(0));
+			permute(perm);
+		}
+
 		/*! \brief Assignment operator
 		 *
 		 * move semantic movement operator=
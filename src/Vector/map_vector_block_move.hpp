@@ -0,0 +1,239 @@
+/*
+ * map_vector_block_move.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_BLOCK_MOVE_HPP_
+#define OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_BLOCK_MOVE_HPP_
+
+#include <cstring>
+#include <type_traits>
+#include "util/check_no_pointers.hpp"
+
+/*! \brief this class is a functor for "for_each" algorithm
+ *
+ * For each property it move a block of elements with memmove. Properties that are
+ * arrays are stored as one plane for each component (of size equal to the allocated
+ * elements of the grid), so every plane is moved
+ *
+ * \tparam T aggregate type
+ * \tparam grid_type grid that store the vector
+ *
+ */
+template<typename T, typename grid_type>
+struct block_move_prop
+{
+	//! grid that store the vector
+	grid_type & base;
+
+	//! destination element
+	size_t dst;
+
+	//! source element
+	size_t src;
+
+	//! number of elements
+	size_t n;
+
+	/*! \brief constructor
+	 *
+	 * \param base grid that store the vector
+	 * \param dst destination element
+	 * \param src source element
+	 * \param n number of elements
+	 *
+	 */
+	block_move_prop(grid_type & base, size_t dst, size_t src, size_t n)
+	:base(base),dst(dst),src(src),n(n)
+	{};
+
+	//! It move the block for the property
+	template<typename t_prp>
+	void operator()(t_prp& t) const
+	{
+		typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<t_prp::value>>::type prop;
+		typedef typename std::remove_all_extents<prop>::type base_type;
+
+		const size_t n_comp = sizeof(prop) / sizeof(base_type);
+		const size_t plane = base.size() * sizeof(base_type);
+
+		unsigned char * ptr = static_cast<unsigned char *>(base.template getPointer<t_prp::value>());
+
+		for (size_t c = 0 ; c < n_comp ; c++)
+			memmove(ptr + c*plane + dst*sizeof(base_type),ptr + c*plane + src*sizeof(base_type),n*sizeof(base_type));
+	}
+};
+
+/*! \brief Move a block of elements of a vector with memmove
+ *
+ * Case memory_traits_lin, the elements are contiguous
+ *
+ * \tparam T aggregate type
+ * \tparam layout layout of the vector
+ *
+ */
+template<typename T, typename layout, unsigned int sel = 2*is_layout_mlin<layout>::value + is_layout_inte<layout>::value >
+struct block_move
+{
+	/*! \brief Move n elements from src to dst (the two ranges can overlap)
+	 *
+	 * \param base grid that store the vector
+	 * \param dst destination element
+	 * \param src source element
+	 * \param n number of elements
+	 *
+	 */
+	template<typename grid_type> static inline void move(grid_type & base, size_t dst, size_t src, size_t n)
+	{
+		unsigned char * ptr = static_cast<unsigned char *>(base.getPointer());
+
+		memmove(ptr + dst*sizeof(typename T::type),ptr + src*sizeof(typename T::type),n*sizeof(typename T::type));
+	}
+};
+
+/*! \brief Move a block of elements of a vector with memmove
+ *
+ * Case memory_traits_inte, one memmove for each property
+ *
+ * \tparam T aggregate type
+ * \tparam layout layout of the vector
+ *
+ */
+template<typename T, typename layout>
+struct block_move<T,layout,1>
+{
+	/*! \brief Move n elements from src to dst (the two ranges can overlap)
+	 *
+	 * \param base grid that store the vector
+	 * \param dst destination element
+	 * \param src source element
+	 * \param n number of elements
+	 *
+	 */
+	template<typename grid_type> static inline void move(grid_type & base, size_t dst, size_t src, size_t n)
+	{
+		block_move_prop<T,grid_type> bm(base,dst,src,n);
+
+		boost::mpl::for_each_ref< boost::mpl::range_c<int,0,T::max_prop> >(bm);
+	}
+};
+
+/*! \brief this class is a functor for "for_each" algorithm
+ *
+ * For each property it gather the elements of the source in the order given by a
+ * permutation (dst element i = src element perm[i]), one pass for each property
+ * (and component plane for array properties)
+ *
+ * \tparam T aggregate type
+ * \tparam grid_type grid that store the vector
+ *
+ */
+template<typename T, typename grid_type>
+struct block_gather_prop
+{
+	//! destination grid
+	grid_type & dst;
+
+	//! source grid
+	grid_type & src;
+
+	//! permutation
+	const size_t * perm;
+
+	//! number of elements
+	size_t n;
+
+	/*! \brief constructor
+	 *
+	 * \param dst destination grid
+	 * \param src source grid
+	 * \param perm permutation
+	 * \param n number of elements
+	 *
+	 */
+	block_gather_prop(grid_type & dst, grid_type & src, const size_t * perm, size_t n)
+	:dst(dst),src(src),perm(perm),n(n)
+	{};
+
+	//! It gather the property
+	template<typename t_prp>
+	void operator()(t_prp& t) const
+	{
+		typedef typename boost::mpl::at<typename T::type,boost::mpl::int_<t_prp::value>>::type prop;
+		typedef typename std::remove_all_extents<prop>::type base_type;
+
+		const size_t n_comp = sizeof(prop) / sizeof(base_type);
+
+		unsigned char * pd = static_cast<unsigned char *>(dst.template getPointer<t_prp::value>());
+		unsigned char * ps = static_cast<unsigned char *>(src.template getPointer<t_prp::value>());
+
+		for (size_t c = 0 ; c < n_comp ; c++)
+		{
+			unsigned char * pd_c = pd + c*dst.size()*sizeof(base_type);
+			unsigned char * ps_c = ps + c*src.size()*sizeof(base_type);
+
+			for (size_t i = 0 ; i < n ; i++)
+				memcpy(pd_c + i*sizeof(base_type),ps_c + perm[i]*sizeof(base_type),sizeof(base_type));
+		}
+	}
+};
+
+/*! \brief Gather the elements of a vector following a permutation with memcpy
+ *
+ * Case memory_traits_lin, one memcpy for each element
+ *
+ * \tparam T aggregate type
+ * \tparam layout layout of the vector
+ *
+ */
+template<typename T, typename layout, unsigned int sel = 2*is_layout_mlin<layout>::value + is_layout_inte<layout>::value >
+struct block_gather
+{
+	/*! \brief dst element i = src element perm[i]
+	 *
+	 * \param dst destination grid
+	 * \param src source grid
+	 * \param perm permutation
+	 * \param n number of elements
+	 *
+	 */
+	template<typename grid_type> static inline void gather(grid_type & dst, grid_type & src, const size_t * perm, size_t n)
+	{
+		unsigned char * pd = static_cast<unsigned char *>(dst.getPointer());
+		unsigned char * ps = static_cast<unsigned char *>(src.getPointer());
+
+		for (size_t i = 0 ; i < n ; i++)
+			memcpy(pd + i*sizeof(typename T::type),ps + perm[i]*sizeof(typename T::type),sizeof(typename T::type));
+	}
+};
+
+/*! \brief Gather the elements of a vector following a permutation with memcpy
+ *
+ * Case memory_traits_inte, one gather for each property
+ *
+ * \tparam T aggregate type
+ * \tparam layout layout of the vector
+ *
+ */
+template<typename T, typename layout>
+struct block_gather<T,layout,1>
+{
+	/*! \brief dst element i = src element perm[i]
+	 *
+	 * \param dst destination grid
+	 * \param src source grid
+	 * \param perm permutation
+	 * \param n number of elements
+	 *
+	 */
+	template<typename grid_type> static inline void gather(grid_type & dst, grid_type & src, const size_t * perm, size_t n)
+	{
+		block_gather_prop<T,grid_type> bg(dst,src,perm,n);
+
+		boost::mpl::for_each_ref< boost::mpl::range_c<int,0,T::max_prop> >(bg);
+	}
+};
+
+#endif /* OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_BLOCK_MOVE_HPP_ */
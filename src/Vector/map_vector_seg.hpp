@@ -0,0 +1,709 @@
+/*
+ * map_vector_seg.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_SEG_HPP_
+#define OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_SEG_HPP_
+
+#include "Vector/map_vector.hpp"
+
+//! Default number of bits of the chunk size (4096 elements for each chunk)
+#define VECTOR_SEG_CHUNK_BITS 12
+
+namespace openfpm
+{
+	/*! \brief Segmented vector
+	 *
+	 * The elements are stored in chunks of 2^chunk_bits elements, every chunk is an
+	 * openfpm::vector that is allocated one time and never reallocated. Adding elements
+	 * allocate new chunks when needed, the existing elements are never moved, so
+	 * growing the vector does not copy the data and the references (and pointers) to the
+	 * elements remain valid.
+	 *
+	 * The interface (get, add, resize, iterators, pack and unpack) is the same of
+	 * openfpm::vector, and the packed message has the same format, so a segmented vector
+	 * can be unpacked into an openfpm::vector and vice versa
+	 *
+	 * ### Add and access elements of a segmented vector
+	 * \snippet vector_unit_tests.hpp Segmented vector
+	 *
+	 * \tparam T type of object the vector store
+	 * \tparam Memory allocator to use
+	 * \tparam layout layout to use
+	 * \tparam layout_base functor to get the layout
+	 * \tparam chunk_bits number of elements of a chunk expressed as a power of two
+	 *
+	 */
+	template<typename T, typename Memory=HeapMemory, typename layout=typename memory_traits_lin<T>::type, template<typename> class layout_base=memory_traits_lin, unsigned int chunk_bits=VECTOR_SEG_CHUNK_BITS>
+	class vector_seg
+	{
+		//! type of a chunk
+		typedef openfpm::vector<T,Memory,layout,layout_base,grow_policy_identity> chunk_type;
+
+		//! number of elements of a chunk
+		static const size_t chunk_size = (size_t)1 << chunk_bits;
+
+		//! mask to get the element inside the chunk
+		static const size_t chunk_mask = chunk_size - 1;
+
+		//! size of the vector
+		size_t v_size;
+
+		//! chunks
+		openfpm::vector<chunk_type *> ch;
+
+		/*! \brief Allocate chunks until the vector can store n elements
+		 *
+		 * \param n number of elements
+		 *
+		 */
+		void alloc_chunks(size_t n)
+		{
+			while (ch.size() * chunk_size < n)
+			{
+				ch.add(new chunk_type());
+				ch.last()->resize(chunk_size);
+			}
+		}
+
+		//! Delete all the chunks
+		void destroy()
+		{
+			for (size_t i = 0 ; i < ch.size() ; i++)
+				delete ch.get(i);
+
+			ch.clear();
+		}
+
+#ifdef SE_CLASS1
+
+		/*! \brief Check that id is not bigger than the vector size
+		 *
+		 * \param id element id
+		 *
+		 */
+		void check_overflow(size_t id) const
+		{
+			if (id >= v_size)
+			{
+				std::cerr << "Error " << __FILE__ << ":" << __LINE__ << " overflow id: " << id << "\n";
+				ACTION_ON_ERROR(VECTOR_ERROR_OBJECT);
+			}
+		}
+
+#endif
+
+	public:
+
+		//! it define that it is a vector
+		typedef int yes_i_am_vector;
+
+		//! Type of the encapsulation memory parameter
+		typedef layout layout_type;
+
+		//! iterator for the vector
+		typedef vector_key_iterator iterator_key;
+
+		//! Object container for T
+		typedef typename chunk_type::container container;
+
+		//! Type of the value the vector is storing
+		typedef T value_type;
+
+		//! Access key for the vector
+		typedef size_t access_key;
+
+		//! Constructor
+		vector_seg()
+		:v_size(0)
+		{}
+
+		/*! \brief Constructor, it create a vector of n elements
+		 *
+		 * \param n number of elements
+		 *
+		 */
+		vector_seg(size_t n)
+		:v_size(0)
+		{
+			resize(n);
+		}
+
+		/*! \brief Copy constructor
+		 *
+		 * \param v vector to copy
+		 *
+		 */
+		vector_seg(const vector_seg<T,Memory,layout,layout_base,chunk_bits> & v)
+		:v_size(0)
+		{
+			this->operator=(v);
+		}
+
+		/*! \brief Constructor from a temporal object
+		 *
+		 * \param v vector to move
+		 *
+		 */
+		vector_seg(vector_seg<T,Memory,layout,layout_base,chunk_bits> && v)
+		:v_size(0)
+		{
+			swap(v);
+		}
+
+		//! Destructor
+		~vector_seg()
+		{
+			destroy();
+		}
+
+		/*! \brief Return the size of the vector
+		 *
+		 * \return the size
+		 *
+		 */
+		size_t size() const
+		{
+			return v_size;
+		}
+
+		/*! \brief Reserve slots in the vector, it allocate the chunks needed
+		 *
+		 * \param sp number of slot to reserve
+		 *
+		 */
+		void reserve(size_t sp)
+		{
+			alloc_chunks(sp);
+		}
+
+		/*! \brief Resize the vector
+		 *
+		 * The chunks are retained when the vector shrink
+		 *
+		 * \param slot number of elements
+		 *
+		 */
+		void resize(size_t slot)
+		{
+			alloc_chunks(slot);
+
+			v_size = slot;
+		}
+
+		/*! \brief Clear the vector
+		 *
+		 * Eliminate all the elements from the vector, the chunks are retained
+		 *
+		 */
+		void clear()
+		{
+			resize(0);
+		}
+
+		/*! \brief Free the chunks that does not contain elements
+		 *
+		 */
+		void shrink_to_fit()
+		{
+			for (size_t i = (v_size + chunk_mask) >> chunk_bits ; i < ch.size() ; i++)
+				delete ch.get(i);
+
+			ch.resize((v_size + chunk_mask) >> chunk_bits);
+		}
+
+		/*! \brief It insert a new empty object on the vector, eventually it allocate a new chunk
+		 *
+		 * No element is moved
+		 *
+		 */
+		void add()
+		{
+			alloc_chunks(v_size + 1);
+
+			v_size++;
+		}
+
+		/*! \brief It insert a new object on the vector, eventually it allocate a new chunk
+		 *
+		 * \param v element to add
+		 *
+		 */
+		void add(const T & v)
+		{
+			alloc_chunks(v_size + 1);
+
+			ch.get(v_size >> chunk_bits)->set(v_size & chunk_mask,v);
+
+			v_size++;
+		}
+
+		/*! \brief It insert a new object on the vector, eventually it allocate a new chunk
+		 *
+		 * \param v object (encapsulated)
+		 *
+		 */
+		void add(const container & v)
+		{
+			alloc_chunks(v_size + 1);
+
+			ch.get(v_size >> chunk_bits)->set(v_size & chunk_mask,v);
+
+			v_size++;
+		}
+
+		/*! \brief Get an element of the vector
+		 *
+		 * \tparam p Property to get
+		 * \param id Element to get
+		 *
+		 * \return the element value requested
+		 *
+		 */
+		template <unsigned int p>
+		inline auto get(size_t id) -> decltype(ch.get(0)->template get<p>(0))
+		{
+#ifdef SE_CLASS1
+			check_overflow(id);
+#endif
+			return ch.get(id >> chunk_bits)->template get<p>(id & chunk_mask);
+		}
+
+		/*! \brief Get an element of the vector
+		 *
+		 * \tparam p Property to get
+		 * \param id Element to get
+		 *
+		 * \return the element value requested
+		 *
+		 */
+		template <unsigned int p>
+		inline auto get(size_t id) const -> decltype(static_cast<const chunk_type *>(ch.get(0))->template get<p>(0))
+		{
+#ifdef SE_CLASS1
+			check_overflow(id);
+#endif
+			return static_cast<const chunk_type *>(ch.get(id >> chunk_bits))->template get<p>(id & chunk_mask);
+		}
+
+		/*! \brief Get an element of the vector
+		 *
+		 * \param id Element to get
+		 *
+		 * \return the element (encapsulated)
+		 *
+		 */
+		inline auto get(size_t id) -> decltype(ch.get(0)->get(0))
+		{
+#ifdef SE_CLASS1
+			check_overflow(id);
+#endif
+			return ch.get(id >> chunk_bits)->get(id & chunk_mask);
+		}
+
+		/*! \brief Get an element of the vector
+		 *
+		 * \param id Element to get
+		 *
+		 * \return the element (encapsulated)
+		 *
+		 */
+		inline auto get(size_t id) const -> decltype(static_cast<const chunk_type *>(ch.get(0))->get(0))
+		{
+#ifdef SE_CLASS1
+			check_overflow(id);
+#endif
+			return static_cast<const chunk_type *>(ch.get(id >> chunk_bits))->get(id & chunk_mask);
+		}
+
+		/*! \brief Get the last element of the vector
+		 *
+		 * \return the element (encapsulated)
+		 *
+		 */
+		inline auto last() -> decltype(ch.get(0)->get(0))
+		{
+			return get(v_size-1);
+		}
+
+		/*! \brief Get the last element of the vector
+		 *
+		 * \return the element (encapsulated)
+		 *
+		 */
+		inline auto last() const -> decltype(static_cast<const chunk_type *>(ch.get(0))->get(0))
+		{
+			return get(v_size-1);
+		}
+
+		/*! \brief Set an element of the vector
+		 *
+		 * \param id element id
+		 * \param obj object to set
+		 *
+		 */
+		void set(size_t id, const T & obj)
+		{
+#ifdef SE_CLASS1
+			check_overflow(id);
+#endif
+			ch.get(id >> chunk_bits)->set(id & chunk_mask,obj);
+		}
+
+		/*! \brief Set an element of the vector
+		 *
+		 * \param id element id
+		 * \param obj object to set (encapsulated)
+		 *
+		 */
+		void set(size_t id, const container & obj)
+		{
+#ifdef SE_CLASS1
+			check_overflow(id);
+#endif
+			ch.get(id >> chunk_bits)->set(id & chunk_mask,obj);
+		}
+
+		/*! \brief Return the number of allocated chunks
+		 *
+		 * \return the number of chunks
+		 *
+		 */
+		size_t getNChunks() const
+		{
+			return ch.size();
+		}
+
+		/*! \brief Return a chunk, the elements from c*getChunkSize() to (c+1)*getChunkSize()
+		 *
+		 * Inside a chunk the elements are contiguous, the size of the chunk vector is
+		 * always getChunkSize(), only the elements up to size() are valid
+		 *
+		 * \param c chunk id
+		 *
+		 * \return the chunk
+		 *
+		 */
+		chunk_type & getChunk(size_t c)
+		{
+			return *ch.get(c);
+		}
+
+		/*! \brief Return the number of elements of a chunk
+		 *
+		 * \return the chunk size
+		 *
+		 */
+		static size_t getChunkSize()
+		{
+			return chunk_size;
+		}
+
+		/*! \brief Get iterator over the elements from a particular index
+		 *
+		 * \param start starting point
+		 *
+		 * \return an iterator to iterate from a particular index
+		 *
+		 */
+		vector_key_iterator getIteratorFrom(size_t start) const
+		{
+			return vector_key_iterator(v_size,start);
+		}
+
+		/*! \brief Get iterator over the elements from 0 until a particular index
+		 *
+		 * \warning stop point is not included
+		 *
+		 * \param stop stop point
+		 *
+		 * \return an iterator to iterate until a particular index
+		 *
+		 */
+		vector_key_iterator getIteratorTo(size_t stop) const
+		{
+			return vector_key_iterator(stop,0);
+		}
+
+		/*! \brief Get the vector elements iterator
+		 *
+		 * \return an iterator to iterate through all the elements of the vector
+		 *
+		 */
+		vector_key_iterator getIterator() const
+		{
+			return vector_key_iterator(v_size);
+		}
+
+		/*! \brief Assignment operator
+		 *
+		 * \param v vector to copy
+		 *
+		 * \return itself
+		 *
+		 */
+		vector_seg<T,Memory,layout,layout_base,chunk_bits> & operator=(const vector_seg<T,Memory,layout,layout_base,chunk_bits> & v)
+		{
+			resize(v.size());
+
+			for (size_t c = 0 ; c < v.ch.size() && c*chunk_size < v.size() ; c++)
+				*ch.get(c) = *v.ch.get(c);
+
+			return *this;
+		}
+
+		/*! \brief Assignment operator from a temporal object
+		 *
+		 * \param v vector to move
+		 *
+		 * \return itself
+		 *
+		 */
+		vector_seg<T,Memory,layout,layout_base,chunk_bits> & operator=(vector_seg<T,Memory,layout,layout_base,chunk_bits> && v)
+		{
+			swap(v);
+
+			return *this;
+		}
+
+		/*! \brief Swap the content of two vectors, no element is copied
+		 *
+		 * \param v vector to swap with
+		 *
+		 */
+		void swap(vector_seg<T,Memory,layout,layout_base,chunk_bits> & v)
+		{
+			ch.swap(v.ch);
+
+			size_t sz_tmp = v_size;
+			v_size = v.v_size;
+			v.v_size = sz_tmp;
+		}
+
+		/*! This Function to indicate the vector class has a packer function
+		 *
+		 * \return true vector has a pack function
+		 *
+		 */
+		static bool pack()
+		{
+			return true;
+		}
+
+		/*! This Function indicate that vector class has a packRequest function
+		 *
+		 * \return true vector has a packRequest function
+		 *
+		 */
+		static bool packRequest()
+		{
+			return true;
+		}
+
+		/*! This Function indicate that vector class has a packMem function
+		 *
+		 * \return true vector has a packMem function
+		 *
+		 */
+		static bool packMem()
+		{
+			return true;
+		}
+
+		/*! \brief Calculate the memory size required to pack n elements
+		 *
+		 * \param n number of elements
+		 * \param e unused
+		 *
+		 * \return the size required
+		 *
+		 */
+		template<int ... prp> static inline size_t packMem(size_t n, size_t e)
+		{
+			return chunk_type::template packMem<prp...>(n,e);
+		}
+
+		/*! \brief It calculate the number of byte required to serialize the object
+		 *
+		 * \tparam prp list of properties
+		 *
+		 * \param req reference to the total counter required to pack the information
+		 *
+		 */
+		template<int ... prp> inline void packRequest(size_t & req) const
+		{
+			//Pushback a sizeof number of elements of the internal vectors
+			req += sizeof(this->size());
+
+			// If all of the aggregate properties do not have a "pack()" member
+			if (has_pack_agg<T,prp...>::result::value == false)
+			{
+				req += this->packMem<prp...>(this->size(),0);
+			}
+			//If at least one property has "pack()"
+			else
+			{
+				for (size_t i = 0 ; i < this->size() ; i++)
+					call_aggregatePackRequest<decltype(this->get(i)),Memory,prp ... >::call_packRequest(this->get(i),req);
+			}
+		}
+
+	private:
+
+		//! These structures serialize a simple (no "pack()" inside) object with specified properties
+		template<bool sel, int ... prp>
+		struct pack_simple_cond
+		{
+			//! serialize the vector
+			static inline void pack(const vector_seg<T,Memory,layout,layout_base,chunk_bits> & obj, ExtPreAlloc<Memory> & mem)
+			{
+				typedef object<typename object_creator<typename T::type,prp...>::type> prp_object;
+				typedef openfpm::vector<prp_object,ExtPreAlloc<Memory>,typename memory_traits_lin<prp_object>::type, memory_traits_lin ,openfpm::grow_policy_identity> dtype;
+
+				// Create an object over the preallocated memory (No allocation is produced)
+				dtype dest;
+				dest.setMemory(mem);
+				dest.resize(obj.size());
+
+				for (size_t i = 0 ; i < obj.size() ; i++)
+				{
+					typedef encapc<1,T,layout> encap_src;
+					typedef encapc<1,prp_object,typename dtype::layout_type> encap_dst;
+
+					// Copy only the selected properties
+					object_si_d<encap_src,encap_dst,OBJ_ENCAP,prp...>(obj.get(i),dest.get(i));
+				}
+			}
+
+			//! de-serialize the vector
+			static inline void unpack(vector_seg<T,Memory,layout,layout_base,chunk_bits> & obj, ExtPreAlloc<Memory> & mem, Unpack_stat & ps)
+			{
+				typedef object<typename object_creator<typename T::type,prp...>::type> prp_object;
+				typedef openfpm::vector<prp_object,PtrMemory,typename memory_traits_lin<prp_object>::type, memory_traits_lin,openfpm::grow_policy_identity> stype;
+
+				size_t size = obj.template packMem<prp...>(obj.size(),0);
+
+				// Create a Pointer object over the preallocated memory (No allocation is produced)
+				PtrMemory & ptr = *(new PtrMemory(mem.getPointerOffset(ps.getOffset()),size));
+
+				stype src;
+				src.setMemory(ptr);
+				src.resize(obj.size());
+
+				for (size_t i = 0 ; i < obj.size() ; i++)
+				{
+					typedef encapc<1,prp_object,typename stype::layout_type> encap_src;
+					typedef encapc<1,T,layout> encap_dst;
+
+					// Copy only the selected properties
+					object_s_di<encap_src,encap_dst,OBJ_ENCAP,prp...>(src.get(i),obj.get(i));
+				}
+
+				ps.addOffset(size);
+			}
+		};
+
+		//! These structures serialize a simple (no "pack()" inside) object without specified properties
+		template<int ... prp>
+		struct pack_simple_cond<true, prp ...>
+		{
+			//! serialize the vector
+			static inline void pack(const vector_seg<T,Memory,layout,layout_base,chunk_bits> & obj, ExtPreAlloc<Memory> & mem)
+			{
+				typedef openfpm::vector<T,ExtPreAlloc<Memory>,layout,layout_base,openfpm::grow_policy_identity> dtype;
+
+				// Create an object over the preallocated memory (No allocation is produced)
+				dtype dest;
+				dest.setMemory(mem);
+				dest.resize(obj.size());
+
+				for (size_t i = 0 ; i < obj.size() ; i++)
+					dest.get(i) = obj.get(i);
+			}
+
+			//! de-serialize the vector
+			static inline void unpack(vector_seg<T,Memory,layout,layout_base,chunk_bits> & obj, ExtPreAlloc<Memory> & mem, Unpack_stat & ps)
+			{
+				typedef openfpm::vector<T,PtrMemory,layout,layout_base,openfpm::grow_policy_identity> stype;
+
+				size_t size = obj.template packMem<prp...>(obj.size(),0);
+
+				// Create a Pointer object over the preallocated memory (No allocation is produced)
+				PtrMemory & ptr = *(new PtrMemory(mem.getPointerOffset(ps.getOffset()),size));
+
+				stype src;
+				src.setMemory(ptr);
+				src.resize(obj.size());
+
+				for (size_t i = 0 ; i < obj.size() ; i++)
+					obj.get(i) = src.get(i);
+
+				ps.addOffset(size);
+			}
+		};
+
+	public:
+
+		/*! \brief pack a vector selecting the properties to pack
+		 *
+		 * The message has the same format of openfpm::vector
+		 *
+		 * \param mem preallocated memory where to pack the vector
+		 * \param sts pack-stat info
+		 *
+		 */
+		template<int ... prp> inline void pack(ExtPreAlloc<Memory> & mem, Pack_stat & sts) const
+		{
+			//Pack the size of a vector
+			Packer<size_t, Memory>::pack(mem,this->size(),sts);
+
+			//If all of the aggregate properties are simple (don't have "pack()" member)
+			if (has_pack_agg<T,prp...>::result::value == false)
+			{
+				pack_simple_cond<sizeof...(prp) == 0,prp...>::pack(*this,mem);
+
+				// Update statistic
+				sts.incReq();
+			}
+			//If at least one property has a "pack()" member
+			else
+			{
+				for (size_t i = 0 ; i < this->size() ; i++)
+					call_aggregatePack<decltype(this->get(i)),Memory,prp ... >::call_pack(this->get(i),mem,sts);
+			}
+		}
+
+		/*! \brief unpack a vector
+		 *
+		 * \param mem preallocated memory from where to unpack the vector
+		 * \param ps unpack-stat info
+		 *
+		 */
+		template<int ... prp> inline void unpack(ExtPreAlloc<Memory> & mem, Unpack_stat & ps)
+		{
+			//Unpack a size of a source vector
+			size_t u2 = 0;
+			Unpacker<size_t, Memory>::unpack(mem,u2,ps);
+
+			//Resize a destination vector
+			this->resize(u2);
+
+			//if all of the aggregate properties are simple (don't have "pack()" member)
+			if (has_pack_agg<T,prp...>::result::value == false)
+			{
+				pack_simple_cond<sizeof...(prp) == 0,prp...>::unpack(*this,mem,ps);
+			}
+			//If at least one is not simple (has a "pack()" member)
+			else
+			{
+				for (size_t i = 0 ; i < this->size() ; i++)
+					call_aggregateUnpack<decltype(this->get(i)),Memory,prp ... >::call_unpack(this->get(i),mem,ps);
+			}
+		}
+	};
+}
+
+#endif /* OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_SEG_HPP_ */
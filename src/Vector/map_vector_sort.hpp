@@ -0,0 +1,151 @@
+/*
+ * map_vector_sort.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: i-bird
+ */
+
+#ifndef OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_SORT_HPP_
+#define OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_SORT_HPP_
+
+#include <vector>
+#include <type_traits>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+//! number of bits sorted in each pass of the radix sort
+#define RADIX_SORT_BITS 8
+
+//! under this number of elements the radix sort use only one thread
+#define RADIX_SORT_MIN_PAR 65536
+
+/*! \brief Stable radix sort of integer keys, it produce the permutation that sort the keys
+ *
+ * LSD radix sort with 8 bits for each pass, passes where all the keys have the same digit
+ * are skipped. With OpenMP every thread count the digits of a contiguous chunk of keys and
+ * scatter them in its own range of the buckets, so the sort remain stable.
+ *
+ * After the call keys[perm[0]] <= keys[perm[1]] <= ... and equal keys keep the original order
+ *
+ * \tparam key_type integer type of the keys (signed or unsigned)
+ *
+ * \param keys keys to sort
+ * \param n number of keys
+ * \param perm output permutation (perm[i] is the position of the i-th smallest key)
+ *
+ */
+template<typename key_type>
+void radix_sort_perm(const key_type * keys, size_t n, size_t * perm)
+{
+	static_assert(std::is_integral<key_type>::value,"radix_sort_perm require integer keys");
+
+	typedef typename std::make_unsigned<key_type>::type ukey;
+
+	const size_t n_bucket = 1 << RADIX_SORT_BITS;
+
+	// with signed keys the sign bit is flipped to have negative numbers first
+	const ukey flip = (std::is_signed<key_type>::value == true)?(ukey)((ukey)1 << (sizeof(ukey)*8-1)):(ukey)0;
+
+	std::vector<ukey> k1(n);
+	std::vector<ukey> k2(n);
+	std::vector<size_t> p2(n);
+
+	for (size_t i = 0 ; i < n ; i++)
+	{
+		k1[i] = (ukey)keys[i] ^ flip;
+		perm[i] = i;
+	}
+
+	ukey * k_src = k1.data();
+	ukey * k_dst = k2.data();
+	size_t * p_src = perm;
+	size_t * p_dst = p2.data();
+
+	size_t n_thr = 1;
+#ifdef _OPENMP
+	if (n >= RADIX_SORT_MIN_PAR)
+		n_thr = omp_get_max_threads();
+#endif
+
+	std::vector<size_t> cnt(n_thr*n_bucket);
+
+	for (size_t shift = 0 ; shift < sizeof(ukey)*8 ; shift += RADIX_SORT_BITS)
+	{
+		// count the digits of each chunk
+
+#ifdef _OPENMP
+		#pragma omp parallel for num_threads(n_thr) schedule(static,1)
+#endif
+		for (size_t t = 0 ; t < n_thr ; t++)
+		{
+			size_t * c = &cnt[t*n_bucket];
+
+			for (size_t b = 0 ; b < n_bucket ; b++)
+				c[b] = 0;
+
+			for (size_t i = n*t/n_thr ; i < n*(t+1)/n_thr ; i++)
+				c[(k_src[i] >> shift) & (n_bucket-1)]++;
+		}
+
+		// if all the keys has the same digit skip the pass
+
+		bool skip = false;
+		for (size_t b = 0 ; b < n_bucket ; b++)
+		{
+			size_t tot = 0;
+			for (size_t t = 0 ; t < n_thr ; t++)
+				tot += cnt[t*n_bucket+b];
+
+			if (tot == n)
+			{skip = true;break;}
+			else if (tot != 0)
+				break;
+		}
+
+		if (skip == true)
+			continue;
+
+		// offset for each bucket and chunk
+
+		size_t off = 0;
+		for (size_t b = 0 ; b < n_bucket ; b++)
+		{
+			for (size_t t = 0 ; t < n_thr ; t++)
+			{
+				size_t c = cnt[t*n_bucket+b];
+				cnt[t*n_bucket+b] = off;
+				off += c;
+			}
+		}
+
+		// scatter
+
+#ifdef _OPENMP
+		#pragma omp parallel for num_threads(n_thr) schedule(static,1)
+#endif
+		for (size_t t = 0 ; t < n_thr ; t++)
+		{
+			size_t * c = &cnt[t*n_bucket];
+
+			for (size_t i = n*t/n_thr ; i < n*(t+1)/n_thr ; i++)
+			{
+				size_t d = c[(k_src[i] >> shift) & (n_bucket-1)]++;
+
+				k_dst[d] = k_src[i];
+				p_dst[d] = p_src[i];
+			}
+		}
+
+		std::swap(k_src,k_dst);
+		std::swap(p_src,p_dst);
+	}
+
+	if (p_src != perm)
+	{
+		for (size_t i = 0 ; i < n ; i++)
+			perm[i] = p_src[i];
+	}
+}
+
+#endif /* OPENFPM_DATA_SRC_VECTOR_MAP_VECTOR_SORT_HPP_ */
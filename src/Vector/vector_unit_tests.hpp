@@ -9,6 +9,7 @@
 #include "Space/Shape/Point.hpp"
 #include "util/object_util.hpp"
 #include "vector_test_util.hpp"
+#include "map_vector_seg.hpp"
 
 BOOST_AUTO_TEST_SUITE( vector_test )
 
@@ -156,6 +157,333 @@ template <typename vector> void test_vector_remove()
 	}
 }
 
+template <typename vector> void test_vector_remove_unordered()
+{
+	typedef Point_test<float> p;
+
+	vector v1;
+
+	for (size_t i = 0 ; i < V_REM_PUSH ; i++)
+	{
+		// Point
+		Point_test<float> p;
+		p.setx(i);
+
+		v1.add(p);
+	}
+
+	//! [Remove unordered]
+
+	openfpm::vector<size_t> rem;
+	openfpm::vector<std::pair<size_t,size_t>> reloc;
+
+	// some keys at the beginning, some random and the last ones
+	std::vector<bool> is_rem(V_REM_PUSH,false);
+
+	for (size_t i = 0 ; i < V_REM_PUSH ; i++)
+	{
+		if (i < 4 || i >= V_REM_PUSH - 6 || rand() % 5 == 0)
+		{
+			rem.add(i);
+			is_rem[i] = true;
+		}
+	}
+
+	v1.remove_unordered(rem,reloc);
+
+	//! [Remove unordered]
+
+	BOOST_REQUIRE_EQUAL(v1.size(),V_REM_PUSH - rem.size());
+	BOOST_REQUIRE(reloc.size() <= rem.size());
+
+	// every surviving element is present exactly one time
+
+	std::vector<size_t> cnt(V_REM_PUSH,0);
+
+	for (size_t i = 0 ; i < v1.size() ; i++)
+		cnt[(size_t)v1.template get<p::x>(i)]++;
+
+	for (size_t i = 0 ; i < V_REM_PUSH ; i++)
+		BOOST_REQUIRE_EQUAL(cnt[i],(is_rem[i] == true)?0ul:1ul);
+
+	// the relocation map is consistent
+
+	for (size_t i = 0 ; i < reloc.size() ; i++)
+		BOOST_REQUIRE_EQUAL((size_t)v1.template get<p::x>(reloc.get(i).second),reloc.get(i).first);
+
+	// the elements not relocated are in the original position
+
+	std::vector<bool> moved(v1.size(),false);
+	for (size_t i = 0 ; i < reloc.size() ; i++)
+		moved[reloc.get(i).second] = true;
+
+	for (size_t i = 0 ; i < v1.size() ; i++)
+	{
+		if (moved[i] == false)
+			BOOST_REQUIRE_EQUAL((size_t)v1.template get<p::x>(i),i);
+	}
+
+	// remove all without relocation map
+
+	rem.clear();
+	for (size_t i = 0 ; i < v1.size() ; i++)
+		rem.add(i);
+
+	v1.remove_unordered(rem);
+
+	BOOST_REQUIRE_EQUAL(v1.size(),0ul);
+}
+
+/*! \brief Check that insert and remove move all the properties (array properties included)
+ *
+ * \tparam vector vector type
+ *
+ */
+template <typename vector> void test_vector_grow()
+{
+	typedef Point_test<float> p;
+
+	vector v1;
+
+	size_t n = 0;
+	size_t steps[] = {1,3,V_REM_PUSH,4*V_REM_PUSH};
+
+	for (size_t s = 0 ; s < sizeof(steps)/sizeof(size_t) ; s++)
+	{
+		v1.resize(steps[s]);
+
+		for (size_t i = n ; i < v1.size() ; i++)
+		{
+			v1.template get<p::x>(i) = i;
+			v1.template get<p::s>(i) = 2*i;
+			v1.template get<p::v>(i)[0] = 3*i;
+			v1.template get<p::v>(i)[2] = 4*i;
+			v1.template get<p::t>(i)[0][2] = 5*i;
+			v1.template get<p::t>(i)[2][1] = 6*i;
+		}
+
+		n = v1.size();
+
+		// the old elements are retained
+
+		for (size_t i = 0 ; i < v1.size() ; i++)
+		{
+			BOOST_REQUIRE_EQUAL(v1.template get<p::x>(i),i);
+			BOOST_REQUIRE_EQUAL(v1.template get<p::s>(i),2*i);
+			BOOST_REQUIRE_EQUAL(v1.template get<p::v>(i)[0],3*i);
+			BOOST_REQUIRE_EQUAL(v1.template get<p::v>(i)[2],4*i);
+			BOOST_REQUIRE_EQUAL(v1.template get<p::t>(i)[0][2],5*i);
+			BOOST_REQUIRE_EQUAL(v1.template get<p::t>(i)[2][1],6*i);
+		}
+	}
+}
+
+template <typename vector_seg> void test_vector_seg()
+{
+	typedef Point_test<float> p;
+
+	//! [Segmented vector]
+
+	vector_seg v1;
+
+	for (size_t i = 0 ; i < 20 ; i++)
+	{
+		v1.add();
+		v1.template get<p::x>(i) = i;
+	}
+
+	// the elements are never moved when the vector grow
+
+	float * ptr0 = &v1.template get<p::x>(0);
+	float * ptr19 = &v1.template get<p::x>(19);
+
+	for (size_t i = 20 ; i < V_REM_PUSH ; i++)
+	{
+		v1.add();
+		v1.template get<p::x>(i) = i;
+	}
+
+	BOOST_REQUIRE(ptr0 == &v1.template get<p::x>(0));
+	BOOST_REQUIRE(ptr19 == &v1.template get<p::x>(19));
+
+	//! [Segmented vector]
+
+	auto it = v1.getIterator();
+
+	while (it.isNext())
+	{
+		auto i = it.get();
+
+		v1.template get<p::s>(i) = 2*i;
+		v1.template get<p::v>(i)[2] = 3*i;
+		v1.template get<p::t>(i)[2][1] = 4*i;
+
+		++it;
+	}
+
+	BOOST_REQUIRE_EQUAL(v1.size(),V_REM_PUSH);
+	BOOST_REQUIRE_EQUAL(v1.getNChunks(),V_REM_PUSH / v1.getChunkSize());
+
+	// copy
+
+	vector_seg v2(v1);
+
+	v2.template get<p::x>(0) = -1.0;
+	BOOST_REQUIRE_EQUAL(v1.template get<p::x>(0),0.0);
+
+	v2.add(v1.get(7));
+	BOOST_REQUIRE_EQUAL(v2.last().template get<p::s>(),14.0);
+
+	// clear retain the chunks, shrink_to_fit free them
+
+	v1.clear();
+	BOOST_REQUIRE_EQUAL(v1.getNChunks(),V_REM_PUSH / v1.getChunkSize());
+	v1.shrink_to_fit();
+	BOOST_REQUIRE_EQUAL(v1.getNChunks(),0ul);
+}
+
+template <typename vector_seg, typename vector> void test_vector_seg_pack()
+{
+	typedef Point_test<float> p;
+
+	vector_seg v1;
+
+	for (size_t i = 0 ; i < V_REM_PUSH ; i++)
+	{
+		v1.add();
+		v1.template get<p::x>(i) = i;
+		v1.template get<p::s>(i) = 2*i;
+		v1.template get<p::v>(i)[2] = 3*i;
+		v1.template get<p::t>(i)[2][1] = 4*i;
+	}
+
+	// pack a segmented vector and unpack into a vector (same message format)
+
+	size_t req = 0;
+	v1.template packRequest<p::x,p::v>(req);
+
+	HeapMemory pmem;
+	ExtPreAlloc<HeapMemory> & mem = *(new ExtPreAlloc<HeapMemory>(req,pmem));
+	mem.incRef();
+
+	Pack_stat sts;
+	v1.template pack<p::x,p::v>(mem,sts);
+
+	Unpack_stat ps;
+	vector v_unp;
+	Unpacker<vector,HeapMemory>::template unpack<p::x,p::v>(mem,v_unp,ps);
+
+	BOOST_REQUIRE_EQUAL(v_unp.size(),v1.size());
+
+	for (size_t i = 0 ; i < v_unp.size() ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(v_unp.template get<p::x>(i),v1.template get<p::x>(i));
+		BOOST_REQUIRE_EQUAL(v_unp.template get<p::v>(i)[2],v1.template get<p::v>(i)[2]);
+	}
+
+	mem.decRef();
+	delete &mem;
+
+	// pack a vector (all the properties) and unpack into a segmented vector
+
+	for (size_t i = 0 ; i < v_unp.size() ; i++)
+	{
+		v_unp.template get<p::s>(i) = v1.template get<p::s>(i);
+		v_unp.template get<p::t>(i)[2][1] = v1.template get<p::t>(i)[2][1];
+	}
+
+	req = 0;
+	v_unp.packRequest(req);
+
+	HeapMemory pmem2;
+	ExtPreAlloc<HeapMemory> & mem2 = *(new ExtPreAlloc<HeapMemory>(req,pmem2));
+	mem2.incRef();
+
+	Pack_stat sts2;
+	v_unp.pack(mem2,sts2);
+
+	Unpack_stat ps2;
+	vector_seg v3;
+	v3.unpack(mem2,ps2);
+
+	BOOST_REQUIRE_EQUAL(v3.size(),v1.size());
+
+	for (size_t i = 0 ; i < v3.size() ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(v3.template get<p::x>(i),v1.template get<p::x>(i));
+		BOOST_REQUIRE_EQUAL(v3.template get<p::s>(i),v1.template get<p::s>(i));
+		BOOST_REQUIRE_EQUAL(v3.template get<p::v>(i)[2],v1.template get<p::v>(i)[2]);
+		BOOST_REQUIRE_EQUAL(v3.template get<p::t>(i)[2][1],v1.template get<p::t>(i)[2][1]);
+	}
+
+	mem2.decRef();
+	delete &mem2;
+}
+
+template <typename vector> void test_vector_insert_remove_block()
+{
+	typedef Point_test<float> p;
+
+	vector v1;
+	std::vector<size_t> ref;
+
+	for (size_t i = 0 ; i < V_REM_PUSH ; i++)
+	{
+		v1.add();
+		v1.template get<p::x>(i) = i;
+		v1.template get<p::s>(i) = 2*i;
+		v1.template get<p::v>(i)[0] = 3*i;
+		v1.template get<p::v>(i)[2] = 4*i;
+		v1.template get<p::t>(i)[2][1] = 5*i;
+
+		ref.push_back(i);
+	}
+
+	// insert at the beginning, in the middle and at the end
+
+	size_t ins[3] = {0,V_REM_PUSH/3,V_REM_PUSH+1};
+
+	for (size_t k = 0 ; k < 3 ; k++)
+	{
+		size_t i = ins[k];
+
+		v1.insert(i);
+		v1.template get<p::x>(i) = 10000 + k;
+		v1.template get<p::s>(i) = 2*(10000 + k);
+		v1.template get<p::v>(i)[0] = 3*(10000 + k);
+		v1.template get<p::v>(i)[2] = 4*(10000 + k);
+		v1.template get<p::t>(i)[2][1] = 5*(10000 + k);
+
+		ref.insert(ref.begin() + i,10000 + k);
+	}
+
+	// remove one element and a set of elements
+
+	v1.remove(5);
+	ref.erase(ref.begin() + 5);
+
+	openfpm::vector<size_t> rem;
+	for (size_t i = 7 ; i < v1.size() ; i += 3)
+		rem.add(i);
+	rem.add(v1.size()-1);
+
+	v1.remove(rem);
+
+	for (long int i = rem.size()-1 ; i >= 0 ; i--)
+		ref.erase(ref.begin() + rem.get(i));
+
+	BOOST_REQUIRE_EQUAL(v1.size(),ref.size());
+
+	for (size_t i = 0 ; i < v1.size() ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(v1.template get<p::x>(i),ref[i]);
+		BOOST_REQUIRE_EQUAL(v1.template get<p::s>(i),2*ref[i]);
+		BOOST_REQUIRE_EQUAL(v1.template get<p::v>(i)[0],3*ref[i]);
+		BOOST_REQUIRE_EQUAL(v1.template get<p::v>(i)[2],4*ref[i]);
+		BOOST_REQUIRE_EQUAL(v1.template get<p::t>(i)[2][1],5*ref[i]);
+	}
+}
+
 template <typename vector> void test_vector_insert()
 {
 	typedef Point_test<float> p;
@@ -444,12 +772,148 @@ BOOST_AUTO_TEST_CASE(vector_remove )
 {
 	test_vector_remove<openfpm::vector<Point_test<float>>>();
 	test_vector_remove< openfpm::vector<Point_test<float>,HeapMemory,memory_traits_inte<Point_test<float>>::type, memory_traits_inte> >();
+	test_vector_remove_unordered<openfpm::vector<Point_test<float>>>();
+	test_vector_remove_unordered< openfpm::vector<Point_test<float>,HeapMemory,memory_traits_inte<Point_test<float>>::type, memory_traits_inte> >();
+}
+
+template <typename vector> void test_vector_permute()
+{
+	typedef Point_test<float> p;
+
+	vector v1;
+
+	for (size_t i = 0 ; i < V_REM_PUSH ; i++)
+	{
+		// Point
+		Point_test<float> pt;
+		pt.fill();
+		pt.setx(i);
+		pt.sety(2*i);
+
+		v1.add(pt);
+	}
+
+	// permutation with cycles of different length
+
+	openfpm::vector<size_t> perm;
+
+	for (size_t i = 0 ; i < V_REM_PUSH ; i++)
+		perm.add((i*7) % V_REM_PUSH);
+
+	v1.permute(perm);
+
+	for (size_t i = 0 ; i < V_REM_PUSH ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(v1.template get<p::x>(i),perm.get(i));
+		BOOST_REQUIRE_EQUAL(v1.template get<p::y>(i),2*perm.get(i));
+		BOOST_REQUIRE_EQUAL(v1.template get<p::t>(i)[1][2],6.0);
+	}
+}
+
+template <typename vector> void test_vector_sort()
+{
+	vector v1;
+
+	for (size_t i = 0 ; i < V_REM_PUSH ; i++)
+	{
+		v1.add();
+		v1.template get<0>(i) = (rand() % 200) - 100;
+		v1.template get<1>(i) = i;
+		v1.template get<2>(i)[0] = i;
+		v1.template get<2>(i)[2] = 3*i;
+	}
+
+	openfpm::vector<int> old_key;
+	for (size_t i = 0 ; i < v1.size() ; i++)
+		old_key.add(v1.template get<0>(i));
+
+	openfpm::vector<size_t> perm;
+	v1.template sort_by<0>(perm);
+
+	BOOST_REQUIRE_EQUAL(perm.size(),v1.size());
+
+	for (size_t i = 0 ; i < v1.size() ; i++)
+	{
+		BOOST_REQUIRE_EQUAL(v1.template get<0>(i),old_key.get(perm.get(i)));
+		BOOST_REQUIRE_EQUAL(v1.template get<1>(i),perm.get(i));
+		BOOST_REQUIRE_EQUAL(v1.template get<2>(i)[0],perm.get(i));
+		BOOST_REQUIRE_EQUAL(v1.template get<2>(i)[2],3*perm.get(i));
+
+		if (i != 0)
+		{
+			// sorted and stable
+			BOOST_REQUIRE(v1.template get<0>(i-1) <= v1.template get<0>(i));
+			if (v1.template get<0>(i-1) == v1.template get<0>(i))
+				BOOST_REQUIRE(v1.template get<1>(i-1) < v1.template get<1>(i));
+		}
+	}
+
+	//! [Sort a vector by key]
+
+	openfpm::vector<size_t> keys;
+	for (size_t i = 0 ; i < v1.size() ; i++)
+		keys.add(((size_t)rand() << 20) + rand());
+
+	v1.sort_by_key(keys,perm);
+
+	//! [Sort a vector by key]
+
+	for (size_t i = 1 ; i < v1.size() ; i++)
+		BOOST_REQUIRE(keys.get(perm.get(i-1)) <= keys.get(perm.get(i)));
+}
+
+BOOST_AUTO_TEST_CASE(vector_sort )
+{
+	test_vector_sort<openfpm::vector<aggregate<int,float,float[3]>>>();
+	test_vector_sort< openfpm::vector<aggregate<int,float,float[3]>,HeapMemory,memory_traits_inte<aggregate<int,float,float[3]>>::type, memory_traits_inte> >();
+
+	// big enough to use more threads
+
+	std::vector<long int> keys(200000);
+	for (size_t i = 0 ; i < keys.size() ; i++)
+		keys[i] = ((long int)rand() << 8) - ((long int)RAND_MAX << 7);
+
+	std::vector<size_t> perm(keys.size());
+	radix_sort_perm(keys.data(),keys.size(),perm.data());
+
+	std::vector<size_t> perm_ref(keys.size());
+	for (size_t i = 0 ; i < keys.size() ; i++)
+		perm_ref[i] = i;
+
+	std::stable_sort(perm_ref.begin(),perm_ref.end(),[&](size_t a, size_t b){return keys[a] < keys[b];});
+
+	for (size_t i = 0 ; i < keys.size() ; i++)
+		BOOST_REQUIRE_EQUAL(perm[i],perm_ref[i]);
+}
+
+BOOST_AUTO_TEST_CASE(vector_permute )
+{
+	test_vector_permute<openfpm::vector<Point_test<float>>>();
+	test_vector_permute< openfpm::vector<Point_test<float>,HeapMemory,memory_traits_inte<Point_test<float>>::type, memory_traits_inte> >();
 }
 
 BOOST_AUTO_TEST_CASE(vector_insert )
 {
 	test_vector_insert<openfpm::vector<Point_test<float>>>();
 	test_vector_insert< openfpm::vector<Point_test<float>,HeapMemory,memory_traits_inte<Point_test<float>>::type, memory_traits_inte > >();
+
+	test_vector_insert_remove_block<openfpm::vector<Point_test<float>>>();
+	test_vector_insert_remove_block< openfpm::vector<Point_test<float>,HeapMemory,memory_traits_inte<Point_test<float>>::type, memory_traits_inte > >();
+}
+
+BOOST_AUTO_TEST_CASE(vector_grow )
+{
+	test_vector_grow<openfpm::vector<Point_test<float>>>();
+	test_vector_grow< openfpm::vector<Point_test<float>,HeapMemory,memory_traits_inte<Point_test<float>>::type, memory_traits_inte > >();
+}
+
+BOOST_AUTO_TEST_CASE(vector_seg_test )
+{
+	test_vector_seg<openfpm::vector_seg<Point_test<float>,HeapMemory,memory_traits_lin<Point_test<float>>::type,memory_traits_lin,4>>();
+	test_vector_seg<openfpm::vector_seg<Point_test<float>,HeapMemory,memory_traits_inte<Point_test<float>>::type,memory_traits_inte,4>>();
+
+	// pack and unpack are supported only by the linear layout
+	test_vector_seg_pack<openfpm::vector_seg<Point_test<float>,HeapMemory,memory_traits_lin<Point_test<float>>::type,memory_traits_lin,4>,openfpm::vector<Point_test<float>>>();
 }
 
 BOOST_AUTO_TEST_CASE(vector_clear )
@@ -53,6 +53,28 @@ class memory_array
 		ptr = static_cast<T *>(ptr_);
 	}
 
+	/*! \brief Set the internal pointer to a buffer that has grown retaining the content
+	 *
+	 * Only the elements from the old size to the new one are constructed
+	 *
+	 * \param ptr_ pointer to the grown buffer
+	 * \param sz_ new number of elements
+	 * \param init specify if the pointer is initialized
+	 *
+	 */
+	void set_pointer_grow(void * ptr_, size_t sz_, bool init)
+	{
+		ptr = static_cast<T *>(ptr_);
+
+		if (init == false)
+		{
+			for (size_t i = sz ; i < sz_ ; i++)
+				new (&ptr[i]) T();
+		}
+
+		sz = sz_;
+	}
+
 	//! Return the pointer
 	void * get_pointer()
 	{
@@ -104,6 +104,26 @@ class memory_c
 	    return true;
 	}
 
+	/*! \brief Grow the memory retaining the content
+	 *
+	 * The buffer is resized by the memory object (that can grow it in place) and
+	 * only the new elements are initialized, the old elements are not copied one by one
+	 *
+	 * \param sz new number of elements (bigger than the actual)
+	 *
+	 */
+	bool grow(const size_t sz)
+	{
+		if (mem_r == NULL)
+			return allocate(sz);
+
+		mem->resize( sz*sizeof(T) );
+
+		mem_r->set_pointer_grow(mem->getPointer(),sz,mem->isInitialized());
+
+		return true;
+	}
+
 	/*! \brief It absorb the allocated object from another memory_c
 	 *
 	 * \param mem_c Memory object
@@ -350,6 +370,36 @@ class memory_c<multi_array<T>, D>
 	    return true;
 	}
 
+	/*! \brief Grow the memory retaining the content
+	 *
+	 * The buffer is resized by the memory object (that can grow it in place), because every
+	 * component is stored in a plane of sz elements the planes are moved to the new stride
+	 * starting from the last one
+	 *
+	 * \param sz new number of elements (bigger than the actual)
+	 *
+	 */
+	bool grow(const size_t sz)
+	{
+		if (mem_r == NULL)
+			return allocate(sz);
+
+		const size_t sz_old = mem_r->shape()[0];
+		const size_t n_comp = mult<T,size_p::value-1>::value;
+
+		mem->resize( sz*n_comp*sizeof(base) );
+
+		unsigned char * ptr = static_cast<unsigned char *>(mem->getPointer());
+
+		for (size_t c = n_comp-1 ; c >= 1 ; c--)
+			memmove(ptr + c*sz*sizeof(base),ptr + c*sz_old*sizeof(base),sz_old*sizeof(base));
+
+		delete(mem_r);
+		mem_r = NULL;
+
+		return allocate(sz);
+	}
+
 	//! define the type of the multi_array vector minus one of the original size
 	//! basically we remove the index 0 of the multi_array
 	typedef boost::multi_array<base,size_p::value> type;